@@ -0,0 +1,126 @@
+#include "alloc_tracker.h"
+
+#if defined(SUPPORT_ALLOC_TRACKING)
+
+#include "raylib.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Atomics since raudio allocates from its own thread
+static std::atomic<uint32_t> allocationCount[ALLOC_MODULE_COUNT];
+static std::atomic<uint64_t> allocationBytes[ALLOC_MODULE_COUNT];
+static uint32_t allocatingFrames = 0;
+
+static void countAllocation(int module, size_t size)
+{
+    if (module < 0 || module >= ALLOC_MODULE_COUNT) module = ALLOC_MODULE_OTHER;
+    allocationCount[module].fetch_add(1, std::memory_order_relaxed);
+    allocationBytes[module].fetch_add(size, std::memory_order_relaxed);
+}
+
+extern "C" void *TrackedMalloc(size_t size, int module)
+{
+    countAllocation(module, size);
+    return malloc(size);
+}
+
+extern "C" void *TrackedCalloc(size_t count, size_t size, int module)
+{
+    countAllocation(module, count*size);
+    return calloc(count, size);
+}
+
+extern "C" void *TrackedRealloc(void *ptr, size_t size, int module)
+{
+    countAllocation(module, size);
+    return realloc(ptr, size);
+}
+
+extern "C" void TrackedFree(void *ptr)
+{
+    free(ptr);
+}
+
+void* operator new(std::size_t size)
+{
+    countAllocation(ALLOC_MODULE_APP, size);
+    void* ptr = malloc((size > 0) ? size : 1);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    TrackedFree(ptr);
+}
+
+// Sized deletes (C++14) go to the same free, the size is not needed
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    TrackedFree(ptr);
+}
+
+void resetAllocationStats()
+{
+    for (int i = 0; i < ALLOC_MODULE_COUNT; i++) {
+        allocationCount[i].store(0, std::memory_order_relaxed);
+        allocationBytes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+AllocationStats getAllocationStats()
+{
+    AllocationStats stats = {};
+    for (int i = 0; i < ALLOC_MODULE_COUNT; i++) {
+        stats.count[i] = allocationCount[i].load(std::memory_order_relaxed);
+        stats.bytes[i] = allocationBytes[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+const char* allocationModuleName(int module)
+{
+    static const char* names[ALLOC_MODULE_COUNT] = { "app", "rcore", "rlgl", "rshapes", "rtext", "rtextures", "other" };
+    return (module >= 0 && module < ALLOC_MODULE_COUNT) ? names[module] : "other";
+}
+
+uint32_t reportFrameAllocations(uint32_t frame)
+{
+    AllocationStats stats = getAllocationStats();
+
+    uint32_t total = 0;
+    for (int i = 0; i < ALLOC_MODULE_COUNT; i++) total += stats.count[i];
+    if (total == 0) return 0;
+
+    allocatingFrames++;
+    TraceLog(LOG_WARNING, "ALLOC: Steady-state frame %u allocated %u times", frame, total);
+    for (int i = 0; i < ALLOC_MODULE_COUNT; i++) {
+        if (stats.count[i] == 0) continue;
+        TraceLog(LOG_WARNING, "ALLOC:     %-9s %u allocations, %llu bytes", allocationModuleName(i),
+                 stats.count[i], (unsigned long long)stats.bytes[i]);
+    }
+    return total;
+}
+
+uint32_t getAllocatingFrameCount()
+{
+    return allocatingFrames;
+}
+
+#endif // SUPPORT_ALLOC_TRACKING
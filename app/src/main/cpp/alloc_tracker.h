@@ -0,0 +1,33 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+// Debug heap allocation counters, only compiled with the ALLOC_TRACKING cmake option.
+// raylib allocations reach them through RL_MALLOC & co. (see config.h), app allocations
+// through the replaced global operator new. Counters are reset at the start of every frame,
+// so a steady-state frame is expected to end with all of them at zero. Steady-state frames are
+// the frames past warmup that neither change a band nor resize the screen: touches that only
+// move the pointer, press buttons or focus bands are steady.
+
+#include "config.h"
+#include <cstdint>
+
+#if defined(SUPPORT_ALLOC_TRACKING)
+
+struct AllocationStats {
+    uint32_t count[ALLOC_MODULE_COUNT];
+    uint64_t bytes[ALLOC_MODULE_COUNT];
+};
+
+void resetAllocationStats();
+AllocationStats getAllocationStats();
+const char* allocationModuleName(int module);
+
+// Logs a warning with the per-module counts when the frame allocated, returns the total count
+uint32_t reportFrameAllocations(uint32_t frame);
+
+// Number of frames reportFrameAllocations() found allocating so far
+uint32_t getAllocatingFrameCount();
+
+#endif // SUPPORT_ALLOC_TRACKING
+
+#endif // ALLOC_TRACKER_H
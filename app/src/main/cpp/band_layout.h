@@ -0,0 +1,232 @@
+#ifndef BAND_LAYOUT_H
+#define BAND_LAYOUT_H
+
+// Band-count-generic decoding: 4 bands (2 digits), 5 bands (3 digits) and 6 bands (3 digits and a
+// temperature coefficient), with gold/silver multipliers (x0.1, x0.01) and IEC 60062 tolerances.
+// Every layout is a template specialization with its own constexpr tables: digit weights per
+// position, multiplier scale, tolerance and tempco per color. Decoding a row is a fixed number
+// of table loads summed together, validity is and-ed from per-color flags, nothing branches
+// on the colors themselves. Values are integers in milliohms, so x0.01 stays exact.
+// The calculator screen keeps its own 4-band rules (resistor_decode.h).
+// GPU-free like resistor_decode.h.
+
+#include "resistor_decode.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace resistor {
+
+// Colors that are not digits, valid as multiplier or tolerance bands
+enum ExtendedColor : uint8_t {
+    Gold = ColorCount, Silver,
+    NoBand,             // Missing tolerance band
+    ExtendedColorCount
+};
+
+struct BandDecode {
+    uint64_t milliohms;
+    uint16_t tolerance;     // Hundredths of a percent
+    uint16_t tempco;        // ppm/K, 6 bands only
+    bool valid;
+};
+
+template <uint8_t BandCount> struct BandLayout;
+
+template <> struct BandLayout<4> {
+    static constexpr uint8_t digitCount = 2;
+    static constexpr bool hasTempco = false;
+};
+
+template <> struct BandLayout<5> {
+    static constexpr uint8_t digitCount = 3;
+    static constexpr bool hasTempco = false;
+};
+
+template <> struct BandLayout<6> {
+    static constexpr uint8_t digitCount = 3;
+    static constexpr bool hasTempco = true;
+};
+
+// Tolerance in hundredths of a percent by color (IEC 60062), 0 when not a tolerance color
+constexpr std::array<uint16_t, ExtendedColorCount> standardTolerance = {
+    0, 100, 200, 0, 0, 50, 25, 10, 5, 0,
+    500, 1000, 2000
+};
+
+// Temperature coefficient in ppm/K by color, 0 when not a tempco color
+constexpr std::array<uint16_t, ExtendedColorCount> standardTempco = {
+    250, 100, 50, 15, 25, 20, 10, 5, 1, 0,
+    0, 0, 0
+};
+
+template <uint8_t BandCount>
+struct LayoutTables {
+    std::array<std::array<uint16_t, ExtendedColorCount>, BandLayout<BandCount>::digitCount> digitWeight;
+    std::array<bool, ExtendedColorCount> isDigit;
+    std::array<uint64_t, ExtendedColorCount> multiplierScale;  // Milliohms per significand unit, 0 if invalid
+    std::array<uint16_t, ExtendedColorCount> tolerance;
+    std::array<uint16_t, ExtendedColorCount> tempco;
+};
+
+template <uint8_t BandCount>
+constexpr LayoutTables<BandCount> makeLayoutTables()
+{
+    constexpr uint8_t digitCount = BandLayout<BandCount>::digitCount;
+
+    LayoutTables<BandCount> tables = {};
+    for (uint8_t color = 0; color < ExtendedColorCount; color++) {
+        bool digit = (color < ColorCount);
+        tables.isDigit[color] = digit;
+        for (uint8_t position = 0; position < digitCount; position++)
+            tables.digitWeight[position][color] = digit ? (uint16_t)(color*powerOf10(digitCount - 1 - position)) : 0;
+
+        if (digit) tables.multiplierScale[color] = powerOf10(color + 3);
+        else if (color == Gold) tables.multiplierScale[color] = 100;
+        else if (color == Silver) tables.multiplierScale[color] = 10;
+
+        // A 4-band resistor may have no tolerance band at all
+        tables.tolerance[color] = (color == NoBand && BandCount != 4) ? 0 : standardTolerance[color];
+        tables.tempco[color] = standardTempco[color];
+    }
+    return tables;
+}
+
+template <uint8_t BandCount>
+struct LayoutDecoder {
+    using Layout = BandLayout<BandCount>;
+
+    static constexpr LayoutTables<BandCount> tables = makeLayoutTables<BandCount>();
+    static constexpr uint8_t multiplierBand = Layout::digitCount;
+    static constexpr uint8_t toleranceBand = Layout::digitCount + 1;
+
+    // Colors out of range decode as NoBand, which is never a digit or multiplier
+    static constexpr uint8_t clampColor(uint8_t color) {
+        return (color < ExtendedColorCount) ? color : (uint8_t)NoBand;
+    }
+
+    // colors holds BandCount entries
+    static constexpr BandDecode decode(const uint8_t* colors) {
+        uint32_t significand = 0;
+        bool valid = true;
+        for (uint8_t position = 0; position < Layout::digitCount; position++) {
+            uint8_t color = clampColor(colors[position]);
+            significand += tables.digitWeight[position][color];
+            valid &= tables.isDigit[color];
+        }
+
+        uint64_t scale = tables.multiplierScale[clampColor(colors[multiplierBand])];
+        uint16_t tolerance = tables.tolerance[clampColor(colors[toleranceBand])];
+
+        BandDecode result = {};
+        result.milliohms = significand*scale;
+        result.tolerance = tolerance;
+        valid &= (scale != 0) & (tolerance != 0);
+
+        if constexpr (Layout::hasTempco) {
+            result.tempco = tables.tempco[clampColor(colors[BandCount - 1])];
+            valid &= (result.tempco != 0);
+        }
+
+        result.valid = valid;
+        return result;
+    }
+
+    // colors holds count rows of BandCount entries
+    static void decodeBatch(const uint8_t* colors, BandDecode* results, size_t count) {
+        for (size_t i = 0; i < count; i++) results[i] = decode(colors + i*BandCount);
+    }
+};
+
+// Runtime band count, dispatches once to the specialized decoder
+inline BandDecode decodeBands(const uint8_t* colors, uint8_t bandCount)
+{
+    switch (bandCount) {
+        case 4: return LayoutDecoder<4>::decode(colors);
+        case 5: return LayoutDecoder<5>::decode(colors);
+        case 6: return LayoutDecoder<6>::decode(colors);
+        default: return BandDecode{};
+    }
+}
+
+inline void decodeBandsBatch(const uint8_t* colors, uint8_t bandCount, BandDecode* results, size_t count)
+{
+    switch (bandCount) {
+        case 4: LayoutDecoder<4>::decodeBatch(colors, results, count); break;
+        case 5: LayoutDecoder<5>::decodeBatch(colors, results, count); break;
+        case 6: LayoutDecoder<6>::decodeBatch(colors, results, count); break;
+        default: for (size_t i = 0; i < count; i++) results[i] = BandDecode{}; break;
+    }
+}
+
+// Same rules as the 4-band screen text (plain below 1000, k/M/B/T with two decimals when not
+// whole), extended to fractional values below 1000 ohms. Needs at least 12 bytes.
+constexpr uint8_t formatMilliohms(uint64_t milliohms, char* text)
+{
+    constexpr char suffixes[5] = { '\0', 'k', 'M', 'B', 'T' };
+
+    uint64_t scale = 1000;
+    uint8_t suffixIndex = 0;
+    while (milliohms/scale >= 1000 && suffixIndex < 4) {
+        scale *= 1000;
+        suffixIndex++;
+    }
+
+    uint64_t whole = milliohms/scale;
+    uint64_t fraction = (milliohms%scale)*100/scale;
+
+    uint8_t pos = appendNumber(text, 0, whole);
+    if (fraction != 0) {
+        text[pos++] = '.';
+        text[pos++] = (char)('0' + fraction/10);
+        text[pos++] = (char)('0' + fraction%10);
+    }
+    if (suffixIndex > 0) text[pos++] = suffixes[suffixIndex];
+    text[pos] = '\0';
+    return pos;
+}
+
+// Percent text of a tolerance in hundredths of a percent, e.g. 25 -> "0.25%"
+constexpr uint8_t formatPercent(uint16_t tolerance, char* text)
+{
+    uint8_t pos = appendNumber(text, 0, tolerance/100);
+    if (tolerance%100 != 0) {
+        text[pos++] = '.';
+        text[pos++] = (char)('0' + (tolerance%100)/10);
+        if (tolerance%10 != 0) text[pos++] = (char)('0' + tolerance%10);
+    }
+    text[pos++] = '%';
+    text[pos] = '\0';
+    return pos;
+}
+
+constexpr bool layoutCheck(uint64_t milliohms, uint16_t tolerance, uint16_t tempco, std::array<uint8_t, 6> colors, uint8_t bandCount)
+{
+    BandDecode result = (bandCount == 4) ? LayoutDecoder<4>::decode(colors.data())
+                      : (bandCount == 5) ? LayoutDecoder<5>::decode(colors.data())
+                      : LayoutDecoder<6>::decode(colors.data());
+    return result.valid && result.milliohms == milliohms && result.tolerance == tolerance && result.tempco == tempco;
+}
+
+constexpr bool formatCheck(uint64_t milliohms, const char* expected)
+{
+    char text[16] = {};
+    formatMilliohms(milliohms, text);
+    return textEqual(text, expected);
+}
+
+static_assert(layoutCheck(4700000, 500, 0, {{ Yellow, Violet, Red, Gold }}, 4), "4 bands");
+static_assert(layoutCheck(470, 1000, 0, {{ Yellow, Violet, Silver, Silver }}, 4), "silver multiplier");
+static_assert(layoutCheck(10000, 2000, 0, {{ Brown, Black, Black, NoBand }}, 4), "missing tolerance band");
+static_assert(layoutCheck(4990000, 100, 0, {{ Yellow, White, White, Brown, Brown }}, 5), "5 bands");
+static_assert(layoutCheck(1050, 50, 0, {{ Brown, Black, Green, Silver, Green }}, 5), "5 bands, x0.01");
+static_assert(layoutCheck(100000000, 25, 50, {{ Brown, Black, Black, Orange, Blue, Red }}, 6), "6 bands");
+static_assert(!LayoutDecoder<4>::decode(std::array<uint8_t, 4>{{ Gold, Black, Red, Gold }}.data()).valid, "gold is not a digit");
+static_assert(!LayoutDecoder<5>::decode(std::array<uint8_t, 5>{{ Brown, Black, Black, Red, NoBand }}.data()).valid, "5 bands need a tolerance band");
+static_assert(formatCheck(4700000, "4.70k"), "same text as the 4-band table");
+static_assert(formatCheck(470, "0.47"), "fractional values below 1000");
+static_assert(formatCheck(99000000000000ULL, "99B"), "billion suffix");
+
+} // namespace resistor
+
+#endif // BAND_LAYOUT_H
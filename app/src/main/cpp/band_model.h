@@ -0,0 +1,81 @@
+#ifndef BAND_MODEL_H
+#define BAND_MODEL_H
+
+// Explicit state of the four bands of the calculator.
+// Every change bumps a version counter, so the view only re-derives its strings
+// and layout when the counter moved instead of comparing colors every frame.
+
+#include "resistor_decode.h"
+#include <array>
+#include <cstdint>
+
+namespace resistor {
+
+enum BandSlot : uint8_t {
+    FirstDigit, SecondDigit, Multiplier, Tolerance,
+    SlotCount
+};
+
+struct BandState {
+    BandColor color;
+    bool set;
+};
+
+class BandModel {
+private:
+    std::array<BandState, SlotCount> states;
+    uint32_t version;
+
+public:
+    BandModel() : states(), version(0) {}
+
+    // Returns true when the band actually changed
+    bool assign(BandSlot slot, BandColor color) {
+        BandState& state = states[slot];
+        if (state.set && state.color == color) return false;
+        state.color = color;
+        state.set = true;
+        version++;
+        return true;
+    }
+
+    bool clear(BandSlot slot) {
+        BandState& state = states[slot];
+        if (!state.set) return false;
+        state.set = false;
+        version++;
+        return true;
+    }
+
+    bool isSet(BandSlot slot) const {
+        return states[slot].set;
+    }
+
+    BandColor getColor(BandSlot slot) const {
+        return states[slot].color;
+    }
+
+    uint32_t getVersion() const {
+        return version;
+    }
+
+    // Value in milliohms (the unit of BandDecode), false until the digits and multiplier are set
+    bool milliohms(uint64_t& value) const {
+        if (!states[FirstDigit].set || !states[SecondDigit].set || !states[Multiplier].set) return false;
+        value = decodeOhms(states[FirstDigit].color, states[SecondDigit].color, states[Multiplier].color)*1000;
+        return true;
+    }
+
+    const char* valueText() const {
+        if (!states[FirstDigit].set || !states[SecondDigit].set || !states[Multiplier].set) return notANumber;
+        return formatValue(states[FirstDigit].color, states[SecondDigit].color, states[Multiplier].color);
+    }
+
+    const char* toleranceText() const {
+        return formatTolerance(states[Tolerance].set ? states[Tolerance].color : ColorCount);
+    }
+};
+
+} // namespace resistor
+
+#endif // BAND_MODEL_H
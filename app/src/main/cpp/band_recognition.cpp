@@ -0,0 +1,363 @@
+#include "band_recognition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace resistor {
+
+// Lab distance of a resistor pixel to the photo border color
+constexpr float foregroundDistance = 20.0f;
+
+// Lab distance of a band to the body color
+constexpr float bandDistance = 14.0f;
+
+// Body bins are at least this fraction of the widest one, leads and end caps are narrower
+constexpr float bodyWidthFraction = 0.5f;
+
+// Half width of the sampled strip around the axis, as a fraction of the body width
+constexpr float coreFraction = 0.3f;
+
+// Shortest side of the photo and of its pyramid level, a very long photo can reduce to a few rows
+constexpr int minimumSide = 16;
+
+constexpr float whiteX = 0.95047f;
+constexpr float whiteZ = 1.08883f;
+
+// sRGB byte to linear intensity
+static const std::array<float, 256>& linearTable()
+{
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values = {};
+        for (int i = 0; i < 256; i++) {
+            float c = i/255.0f;
+            values[i] = (c <= 0.04045f) ? c/12.92f : std::pow((c + 0.055f)/1.055f, 2.4f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+// Cube root for [0, 1], exponent trick guess and two Newton steps, vectorizes unlike cbrtf
+static inline float cubeRoot(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits = bits/3 + 709921077u;
+    float y;
+    std::memcpy(&y, &bits, sizeof(y));
+    y = (2.0f*y + x/(y*y))*(1.0f/3.0f);
+    y = (2.0f*y + x/(y*y))*(1.0f/3.0f);
+    return y;
+}
+
+static inline float labCurve(float t)
+{
+    return (t > 0.008856f) ? cubeRoot(t) : 7.787f*t + 16.0f/116.0f;
+}
+
+// Linear RGB planes to L, a, b in place
+static void linearToLab(float* r, float* g, float* b, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        float x = (0.4124f*r[i] + 0.3576f*g[i] + 0.1805f*b[i])*(1.0f/whiteX);
+        float y = 0.2126f*r[i] + 0.7152f*g[i] + 0.0722f*b[i];
+        float z = (0.0193f*r[i] + 0.1192f*g[i] + 0.9505f*b[i])*(1.0f/whiteZ);
+
+        float fx = labCurve(x);
+        float fy = labCurve(y);
+        float fz = labCurve(z);
+
+        r[i] = 116.0f*fy - 16.0f;
+        g[i] = 500.0f*(fx - fy);
+        b[i] = 200.0f*(fy - fz);
+    }
+}
+
+static inline float distanceSquared(const LabColor& p, const LabColor& q)
+{
+    return (p.l - q.l)*(p.l - q.l) + (p.a - q.a)*(p.a - q.a) + (p.b - q.b)*(p.b - q.b);
+}
+
+static float median(std::vector<float>& values)
+{
+    auto middle = values.begin() + values.size()/2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+LabColor BandRecognizer::toLab(RgbColor color)
+{
+    const std::array<float, 256>& linear = linearTable();
+    float r = linear[color.r];
+    float g = linear[color.g];
+    float b = linear[color.b];
+    linearToLab(&r, &g, &b, 1);
+    return { r, g, b };
+}
+
+BandRecognizer::BandRecognizer(const std::array<RgbColor, ColorCount>& palette)
+{
+    for (uint8_t color = 0; color < ColorCount; color++) centroids[color] = toLab(palette[color]);
+    centroids[Gold] = toLab(goldBand);
+    centroids[Silver] = toLab(silverBand);
+}
+
+// Box filter of factor x factor pixels into linear RGB planes: rows are summed per column first
+// (contiguous bytes), then each output pixel adds factor column sums
+void BandRecognizer::downscale(const uint8_t* rgba, int stride, int factor, int levelWidth, int levelHeight)
+{
+    const std::array<float, 256>& linear = linearTable();
+    size_t rowBytes = (size_t)levelWidth*factor*4;
+    float scale = 1.0f/(float)(factor*factor);
+
+    columnSums.resize(rowBytes);
+
+    for (int y = 0; y < levelHeight; y++) {
+        uint16_t* sums = columnSums.data();
+        std::fill(sums, sums + rowBytes, 0);
+
+        for (int row = 0; row < factor; row++) {
+            const uint8_t* pixels = rgba + (size_t)(y*factor + row)*stride;
+            for (size_t i = 0; i < rowBytes; i++) sums[i] += pixels[i];
+        }
+
+        float* r = &lightness[(size_t)y*levelWidth];
+        float* g = &greenRed[(size_t)y*levelWidth];
+        float* b = &blueYellow[(size_t)y*levelWidth];
+        for (int x = 0; x < levelWidth; x++) {
+            const uint16_t* block = sums + (size_t)x*factor*4;
+            uint32_t red = 0, green = 0, blue = 0;
+            for (int k = 0; k < factor; k++) {
+                red += block[k*4];
+                green += block[k*4 + 1];
+                blue += block[k*4 + 2];
+            }
+            r[x] = linear[(uint8_t)(red*scale + 0.5f)];
+            g[x] = linear[(uint8_t)(green*scale + 0.5f)];
+            b[x] = linear[(uint8_t)(blue*scale + 0.5f)];
+        }
+    }
+}
+
+RecognizedBands BandRecognizer::recognize(const uint8_t* rgba, int width, int height, int stride)
+{
+    RecognizedBands result = {};
+    if (rgba == nullptr || width < minimumSide || height < minimumSide) return result;
+
+    // Pyramid level: smallest power of two reduction that fits the working size
+    int factor = 1;
+    while (std::max(width, height)/factor > workingSize) factor *= 2;
+    int levelWidth = width/factor;
+    int levelHeight = height/factor;
+    if (levelWidth < minimumSide || levelHeight < minimumSide) return result;
+    size_t pixelCount = (size_t)levelWidth*levelHeight;
+
+    lightness.resize(pixelCount);
+    greenRed.resize(pixelCount);
+    blueYellow.resize(pixelCount);
+    foreground.resize(pixelCount);
+
+    downscale(rgba, stride, factor, levelWidth, levelHeight);
+    linearToLab(lightness.data(), greenRed.data(), blueYellow.data(), pixelCount);
+
+    // Background color: per channel median of a thin frame along the border
+    int frame = std::max(1, std::min(levelWidth, levelHeight)/32);
+    std::vector<float> border[3];
+    for (int y = 0; y < levelHeight; y++) {
+        for (int x = 0; x < levelWidth; x++) {
+            if (x >= frame && x < levelWidth - frame && y >= frame && y < levelHeight - frame) {
+                x = levelWidth - frame - 1;
+                continue;
+            }
+            size_t i = (size_t)y*levelWidth + x;
+            border[0].push_back(lightness[i]);
+            border[1].push_back(greenRed[i]);
+            border[2].push_back(blueYellow[i]);
+        }
+    }
+    LabColor background = { median(border[0]), median(border[1]), median(border[2]) };
+
+    // Foreground mask, vectorized distance kernel
+    constexpr float foregroundSquared = foregroundDistance*foregroundDistance;
+    for (size_t i = 0; i < pixelCount; i++) {
+        float dl = lightness[i] - background.l;
+        float da = greenRed[i] - background.a;
+        float db = blueYellow[i] - background.b;
+        foreground[i] = (dl*dl + da*da + db*db > foregroundSquared) ? 1 : 0;
+    }
+
+    // Resistor axis: principal direction of the foreground pixels
+    double count = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumYY = 0.0, sumXY = 0.0;
+    for (int y = 0; y < levelHeight; y++) {
+        const uint8_t* mask = &foreground[(size_t)y*levelWidth];
+        double rowCount = 0.0, rowX = 0.0, rowXX = 0.0;
+        for (int x = 0; x < levelWidth; x++) {
+            double m = mask[x];
+            rowCount += m;
+            rowX += m*x;
+            rowXX += m*x*x;
+        }
+        count += rowCount;
+        sumX += rowX;
+        sumY += rowCount*y;
+        sumXX += rowXX;
+        sumYY += rowCount*y*y;
+        sumXY += rowX*y;
+    }
+    if (count < 64.0) return result;
+
+    double centerX = sumX/count;
+    double centerY = sumY/count;
+    double covXX = sumXX/count - centerX*centerX;
+    double covYY = sumYY/count - centerY*centerY;
+    double covXY = sumXY/count - centerX*centerY;
+    double angle = 0.5*std::atan2(2.0*covXY, covXX - covYY);
+    float dirX = (float)std::cos(angle);
+    float dirY = (float)std::sin(angle);
+
+    // Width profile: foreground pixels per bin along the axis, and their mean offset across it
+    int half = (int)std::ceil(std::sqrt((double)levelWidth*levelWidth + (double)levelHeight*levelHeight));
+    size_t binCount = (size_t)(2*half + 1);
+    widths.assign(binCount, 0);
+    std::vector<float> offsets(binCount, 0.0f);
+
+    for (int y = 0; y < levelHeight; y++) {
+        const uint8_t* mask = &foreground[(size_t)y*levelWidth];
+        float py = (float)(y - centerY);
+        for (int x = 0; x < levelWidth; x++) {
+            if (mask[x] == 0) continue;
+            float px = (float)(x - centerX);
+            int bin = (int)std::lround(px*dirX + py*dirY) + half;
+            widths[bin]++;
+            offsets[bin] += py*dirX - px*dirY;
+        }
+    }
+
+    // Body: longest run of wide bins, gaps up to the body width (a band close to the background) bridged
+    uint16_t widest = *std::max_element(widths.begin(), widths.end());
+    uint16_t wide = (uint16_t)std::max(1.0f, widest*bodyWidthFraction);
+    int maxGap = widest;
+
+    int bodyFirst = 0, bodyLast = -1;
+    int runFirst = -1, lastWide = -1;
+    for (int bin = 0; bin < (int)binCount; bin++) {
+        if (widths[bin] < wide) continue;
+        if (runFirst < 0 || bin - lastWide > maxGap) runFirst = bin;
+        lastWide = bin;
+        if (lastWide - runFirst > bodyLast - bodyFirst) {
+            bodyFirst = runFirst;
+            bodyLast = lastWide;
+        }
+    }
+    int bodyLength = bodyLast - bodyFirst + 1;
+    if (bodyLength < 16) return result;
+
+    double offsetSum = 0.0, offsetCount = 0.0;
+    for (int bin = bodyFirst; bin <= bodyLast; bin++) {
+        offsetSum += offsets[bin];
+        offsetCount += widths[bin];
+    }
+    float across = (float)(offsetSum/std::max(1.0, offsetCount));
+
+    // 1D projection: mean Lab of a strip around the axis for every body bin
+    int core = std::max(1, (int)(widest*coreFraction));
+    profile.assign((size_t)bodyLength, LabColor{ 0.0f, 0.0f, 0.0f });
+
+    for (int bin = bodyFirst; bin <= bodyLast; bin++) {
+        float t = (float)(bin - half);
+        LabColor sum = { 0.0f, 0.0f, 0.0f };
+        int samples = 0;
+        for (int s = -core; s <= core; s++) {
+            float offset = across + (float)s;
+            int x = (int)std::lround(centerX + t*dirX - offset*dirY);
+            int y = (int)std::lround(centerY + t*dirY + offset*dirX);
+            if (x < 0 || y < 0 || x >= levelWidth || y >= levelHeight) continue;
+            size_t i = (size_t)y*levelWidth + x;
+            sum.l += lightness[i];
+            sum.a += greenRed[i];
+            sum.b += blueYellow[i];
+            samples++;
+        }
+        float inverse = 1.0f/(float)std::max(1, samples);
+        profile[bin - bodyFirst] = { sum.l*inverse, sum.a*inverse, sum.b*inverse };
+    }
+
+    // Body color: bands are narrow, the per channel median is the body
+    std::vector<float> channel(profile.size());
+    LabColor body;
+    for (size_t i = 0; i < profile.size(); i++) channel[i] = profile[i].l;
+    body.l = median(channel);
+    for (size_t i = 0; i < profile.size(); i++) channel[i] = profile[i].a;
+    body.a = median(channel);
+    for (size_t i = 0; i < profile.size(); i++) channel[i] = profile[i].b;
+    body.b = median(channel);
+
+    // Bands: runs of bins away from the body color, too short runs are noise or reflections
+    struct Run { int first, last; };
+    std::vector<Run> runs;
+    int minLength = std::max(2, bodyLength/40);
+    constexpr float bandSquared = bandDistance*bandDistance;
+
+    int start = -1;
+    for (int i = 0; i <= bodyLength; i++) {
+        bool band = (i < bodyLength) && distanceSquared(profile[i], body) > bandSquared;
+        if (band && start < 0) start = i;
+        if (!band && start >= 0) {
+            if (i - start >= minLength) runs.push_back({ start, i - 1 });
+            start = -1;
+        }
+    }
+
+    result.count = (uint8_t)std::min<size_t>(runs.size(), 255);
+    if (runs.size() < 3 || runs.size() > maxRecognizedBands) return result;
+
+    // Nearest centroid on the middle of every run, away from the blurred edges
+    for (size_t band = 0; band < runs.size(); band++) {
+        int trim = (runs[band].last - runs[band].first + 1)/4;
+        LabColor mean = { 0.0f, 0.0f, 0.0f };
+        for (int i = runs[band].first + trim; i <= runs[band].last - trim; i++) {
+            mean.l += profile[i].l;
+            mean.a += profile[i].a;
+            mean.b += profile[i].b;
+        }
+        float inverse = 1.0f/(float)(runs[band].last - runs[band].first + 1 - 2*trim);
+        mean = { mean.l*inverse, mean.a*inverse, mean.b*inverse };
+
+        uint8_t nearest = 0;
+        float nearestDistance = distanceSquared(mean, centroids[0]);
+        for (uint8_t color = 1; color < NoBand; color++) {
+            float distance = distanceSquared(mean, centroids[color]);
+            if (distance < nearestDistance) {
+                nearest = color;
+                nearestDistance = distance;
+            }
+        }
+        result.colors[band] = nearest;
+        result.distance[band] = std::sqrt(nearestDistance);
+    }
+
+    // Reading order: gold and silver never come first, otherwise the tolerance band is the one
+    // set apart by the wider gap
+    size_t last = runs.size() - 1;
+    bool firstMetallic = result.colors[0] >= Gold;
+    bool lastMetallic = result.colors[last] >= Gold;
+    int firstGap = runs[1].first - runs[0].last;
+    int lastGap = runs[last].first - runs[last - 1].last;
+    if ((firstMetallic && !lastMetallic) || (firstMetallic == lastMetallic && 2*firstGap > 3*lastGap)) {
+        std::reverse(result.colors.begin(), result.colors.begin() + runs.size());
+        std::reverse(result.distance.begin(), result.distance.begin() + runs.size());
+    }
+
+    if (runs.size() == 3) {
+        uint8_t colors[4] = { result.colors[0], result.colors[1], result.colors[2], NoBand };
+        result.decode = decodeBands(colors, 4);
+    }
+    else {
+        result.decode = decodeBands(result.colors.data(), (uint8_t)runs.size());
+    }
+
+    return result;
+}
+
+} // namespace resistor
@@ -0,0 +1,77 @@
+#ifndef BAND_RECOGNITION_H
+#define BAND_RECOGNITION_H
+
+// Band recognition from a photo of a single resistor (RGBA8 pixels, e.g. a raylib Image).
+// The photo is reduced to a working size first (a level of a box pyramid, computed in one pass),
+// converted to CIE Lab with plain array kernels the compiler vectorizes, and the resistor is
+// found against the border color. Its axis comes from the principal direction of the foreground,
+// the body is then projected to a 1D Lab profile along that axis: bands are the runs that differ
+// from the body color, each one classified to the nearest palette centroid in Lab.
+// The palette is the one of the calculator buttons plus gold and silver.
+// GPU-free like resistor_decode.h.
+
+#include "band_layout.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace resistor {
+
+struct RgbColor {
+    uint8_t r, g, b;
+};
+
+struct LabColor {
+    float l, a, b;
+};
+
+// Same values as the raylib colors of the calculator buttons, in BandColor order
+constexpr std::array<RgbColor, ColorCount> buttonPalette = {{
+    { 0, 0, 0 }, { 127, 106, 79 }, { 230, 41, 55 }, { 255, 161, 0 }, { 253, 249, 0 },
+    { 0, 228, 48 }, { 0, 121, 241 }, { 135, 60, 190 }, { 130, 130, 130 }, { 255, 255, 255 }
+}};
+
+// Metallic bands as they usually photograph
+constexpr RgbColor goldBand = { 176, 141, 60 };
+constexpr RgbColor silverBand = { 170, 172, 176 };
+
+constexpr uint8_t maxRecognizedBands = 6;
+
+struct RecognizedBands {
+    uint8_t count;                                      // 0 when no resistor or band set was found
+    std::array<uint8_t, maxRecognizedBands> colors;     // BandColor, Gold or Silver, in reading order
+    std::array<float, maxRecognizedBands> distance;     // Lab distance to the chosen centroid
+    BandDecode decode;                                  // 3 bands decode as 4 with no tolerance band
+};
+
+class BandRecognizer {
+public:
+    static constexpr int workingSize = 512;         // Longest side of the analysed pyramid level
+
+private:
+    std::array<LabColor, NoBand> centroids;
+
+    // Working level and 1D profile, reused between photos
+    std::vector<float> lightness;
+    std::vector<float> greenRed;
+    std::vector<float> blueYellow;
+    std::vector<uint8_t> foreground;
+    std::vector<uint16_t> columnSums;
+    std::vector<LabColor> profile;
+    std::vector<uint16_t> widths;
+
+    void downscale(const uint8_t* rgba, int stride, int factor, int levelWidth, int levelHeight);
+
+public:
+    explicit BandRecognizer(const std::array<RgbColor, ColorCount>& palette = buttonPalette);
+
+    // stride in bytes, the photo is only read
+    RecognizedBands recognize(const uint8_t* rgba, int width, int height, int stride);
+
+    static LabColor toLab(RgbColor color);
+};
+
+} // namespace resistor
+
+#endif // BAND_RECOGNITION_H
@@ -154,10 +154,15 @@
 // Use QUADS instead of TRIANGLES for drawing when possible
 // Some lines-based shapes could still use lines
 #define SUPPORT_QUADS_DRAW_MODE         1
+// Cache rounded rectangles corner arcs by radius and segments, avoids recomputing
+// segments count and sin/cos for every vertex when the same shapes are drawn every frame
+#define SUPPORT_ROUNDED_RECT_CACHE      1
 
 // rshapes: Configuration values
 //------------------------------------------------------------------------------------
 #define SPLINE_SEGMENT_DIVISIONS       24       // Spline segments subdivisions
+#define ROUNDED_RECT_CACHE_SIZE        16       // Maximum rounded rectangle corner arcs cached
+#define ROUNDED_RECT_CACHE_MAX_SEGMENTS 32      // Maximum segments per corner for a cached arc
 
 
 //------------------------------------------------------------------------------------
@@ -167,7 +172,7 @@
 #define SUPPORT_FILEFORMAT_PNG      1
 //#define SUPPORT_FILEFORMAT_BMP      1
 //#define SUPPORT_FILEFORMAT_TGA      1
-//#define SUPPORT_FILEFORMAT_JPG      1
+#define SUPPORT_FILEFORMAT_JPG      1       // Camera photos for band recognition
 #define SUPPORT_FILEFORMAT_GIF      1
 #define SUPPORT_FILEFORMAT_QOI      1
 //#define SUPPORT_FILEFORMAT_PSD      1
@@ -198,6 +203,9 @@
 #define SUPPORT_FILEFORMAT_TTF          1
 #define SUPPORT_FILEFORMAT_FNT          1
 //#define SUPPORT_FILEFORMAT_BDF          1
+// Baked fonts (.rfnt) hold the glyph metrics and atlas pixels written by ExportFontBaked(), loading
+// them is a texture upload with no rasterization (a compressed atlas requires SUPPORT_COMPRESSION_API)
+#define SUPPORT_FILEFORMAT_RFNT         1
 
 // Support text management functions
 // If not defined, still some functions are supported: TextLength(), TextFormat()
@@ -208,11 +216,26 @@
 // drawing text and shapes with a single draw call [SetShapesTexture()].
 #define SUPPORT_FONT_ATLAS_WHITE_REC    1
 
+// Fonts get a codepoint to glyph index table when loaded, GetGlyphIndex() is then a direct lookup
+// instead of a linear search over the glyphs (BMP pages direct, other codepoints hashed)
+#define SUPPORT_GLYPH_INDEX_TABLE       1
+
+// TTF glyphs are rasterized over several threads on font loading, one per core at most
+// NOTE: Requires pthreads, results are the same as a single threaded load
+#define SUPPORT_FONT_LOAD_THREADS       1
+
+// DrawTextEx() and MeasureTextEx() keep the layout of recently used strings, text drawn every frame
+// is then submitted as cached glyph quads instead of being decoded and measured again
+#define SUPPORT_TEXT_LAYOUT_CACHE       1
+
 // rtext: Configuration values
 //------------------------------------------------------------------------------------
 #define MAX_TEXT_BUFFER_LENGTH       1024       // Size of internal static buffers used on some functions:
                                                 // TextFormat(), TextSubtext(), TextToUpper(), TextToLower(), TextToPascal(), TextSplit()
 #define MAX_TEXTSPLIT_COUNT           128       // Maximum number of substrings to split: TextSplit()
+#define FONT_LOAD_MAX_THREADS           8       // Maximum threads rasterizing glyphs on font loading
+#define TEXT_LAYOUT_CACHE_SIZE          8       // Text layouts kept by DrawTextEx() and MeasureTextEx()
+#define TEXT_LAYOUT_CACHE_MAX_LENGTH  256       // Longer strings are not cached
 
 
 //------------------------------------------------------------------------------------
@@ -300,4 +323,47 @@
     #endif
 #endif
 
+//------------------------------------------------------------------------------------
+// Allocation tracking (debug) - Enabled with the ALLOC_TRACKING cmake option
+//------------------------------------------------------------------------------------
+// RL_MALLOC/RL_CALLOC/RL_REALLOC/RL_FREE are routed to counters implemented by the application
+// (alloc_tracker.cpp), ALLOC_MODULE is defined per source file by cmake to attribute allocations
+// NOTE: rlgl implementation is compiled inside rcore.c, it switches ALLOC_MODULE around its include
+#if defined(SUPPORT_ALLOC_TRACKING)
+    #define ALLOC_MODULE_APP            0
+    #define ALLOC_MODULE_RCORE          1
+    #define ALLOC_MODULE_RLGL           2
+    #define ALLOC_MODULE_RSHAPES        3
+    #define ALLOC_MODULE_RTEXT          4
+    #define ALLOC_MODULE_RTEXTURES      5
+    #define ALLOC_MODULE_OTHER          6       // rmodels, raudio, utils
+    #define ALLOC_MODULE_COUNT          7
+
+    #ifndef ALLOC_MODULE
+        #define ALLOC_MODULE ALLOC_MODULE_OTHER
+    #endif
+
+    #include <stddef.h>
+
+    #if defined(__cplusplus)
+    extern "C" {
+    #endif
+    void *TrackedMalloc(size_t size, int module);
+    void *TrackedCalloc(size_t count, size_t size, int module);
+    void *TrackedRealloc(void *ptr, size_t size, int module);
+    void TrackedFree(void *ptr);
+    #if defined(__cplusplus)
+    }
+    #endif
+
+    #undef RL_MALLOC
+    #undef RL_CALLOC
+    #undef RL_REALLOC
+    #undef RL_FREE
+    #define RL_MALLOC(sz)       TrackedMalloc(sz, ALLOC_MODULE)
+    #define RL_CALLOC(n,sz)     TrackedCalloc(n, sz, ALLOC_MODULE)
+    #define RL_REALLOC(ptr,sz)  TrackedRealloc(ptr, sz, ALLOC_MODULE)
+    #define RL_FREE(ptr)        TrackedFree(ptr)
+#endif
+
 #endif // CONFIG_H
@@ -99,10 +99,20 @@
   #define RPRAND_LOG(...)
 #endif
 
+// Number of independent Xoshiro128** streams advanced together by the batch generator
+#ifndef RPRAND_BATCH_LANES
+    #define RPRAND_BATCH_LANES      8
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-//...
+// Batch generator state, one Xoshiro128** state per lane stored interleaved (structure of arrays)
+// NOTE: Unlike rprand_set_seed()/rprand_get_value(), it does not use the global state,
+// so every thread can own its batch generator
+typedef struct rprand_batch {
+    unsigned int state[4][RPRAND_BATCH_LANES];
+} rprand_batch;
 
 #ifdef __cplusplus
 extern "C" {                // Prevents name mangling of functions
@@ -122,6 +132,9 @@ RPRANDAPI int rprand_get_value(int min, int max);               // Get random va
 RPRANDAPI int *rprand_load_sequence(unsigned int count, int min, int max); // Load pseudo-random numbers sequence with no duplicates
 RPRANDAPI void rprand_unload_sequence(int *sequence);           // Unload pseudo-random numbers sequence
 
+RPRANDAPI void rprand_batch_set_seed(rprand_batch *batch, unsigned long long seed); // Set all lanes state from a 64bit seed
+RPRANDAPI void rprand_batch_fill(rprand_batch *batch, unsigned int *values, unsigned int count); // Fill values with 32bit random numbers
+
 #ifdef __cplusplus
 }
 #endif
@@ -308,4 +321,57 @@ uint64_t rprand_splitmix64()
     return z ^ (z >> 31);
 }
 
+// Set every lane state of a batch generator
+// NOTE: Lanes are seeded from consecutive SplitMix64 outputs of the given seed,
+// the global rprand_seed is not modified
+void rprand_batch_set_seed(rprand_batch *batch, unsigned long long seed)
+{
+    uint64_t z = 0;
+
+    for (int lane = 0; lane < RPRAND_BATCH_LANES; lane++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            // Same SplitMix64 step as rprand_splitmix64(), on a local seed
+            z = (seed += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27))*0x94d049bb133111eb;
+            z = z ^ (z >> 31);
+
+            batch->state[i][lane] = (i%2 == 0)? (uint32_t)(z & 0xffffffff) : (uint32_t)((z & 0xffffffff00000000) >> 32);
+        }
+    }
+}
+
+// Fill values with pseudo-random numbers, lanes interleaved
+// NOTE: Every lane runs the same Xoshiro128** step as rprand_xoshiro(), the inner loop
+// has no dependency between lanes so it maps to SIMD registers
+void rprand_batch_fill(rprand_batch *batch, unsigned int *values, unsigned int count)
+{
+    uint32_t group[RPRAND_BATCH_LANES] = { 0 };
+
+    for (unsigned int i = 0; i < count; i += RPRAND_BATCH_LANES)
+    {
+        for (int lane = 0; lane < RPRAND_BATCH_LANES; lane++)
+        {
+            const uint32_t result = rprand_rotate_left(batch->state[1][lane]*5, 7)*9;
+            const uint32_t t = batch->state[1][lane] << 9;
+
+            batch->state[2][lane] ^= batch->state[0][lane];
+            batch->state[3][lane] ^= batch->state[1][lane];
+            batch->state[1][lane] ^= batch->state[2][lane];
+            batch->state[0][lane] ^= batch->state[3][lane];
+
+            batch->state[2][lane] ^= t;
+
+            batch->state[3][lane] = rprand_rotate_left(batch->state[3][lane], 11);
+
+            group[lane] = result;
+        }
+
+        unsigned int remaining = count - i;
+        for (unsigned int lane = 0; (lane < RPRAND_BATCH_LANES) && (lane < remaining); lane++) values[i + lane] = group[lane];
+    }
+}
+
 #endif  // RPRAND_IMPLEMENTATION
\ No newline at end of file
@@ -56,6 +56,13 @@
 //       Kenney Phillis Jr.         Brian Costabile
 //       Ken Voskuil (kaesve)       Yakov Galka
 //
+// LOCAL CHANGES (keep when updating, rtext.c checks for them)
+//
+//   stbtt_GetGlyphSDF() splits the cubic curves of CFF/OpenType glyphs into
+//   quadratic curves before computing distances, stbtt__sdf_split_cubics().
+//   v1.26 ignores cubics there, CFF glyph SDFs only get their straight edges.
+//   Changed lines are enclosed in "LOCAL CHANGE" comments.
+//
 // VERSION HISTORY
 //
 //   1.26 (2021-08-28) fix broken rasterizer
@@ -4572,6 +4579,59 @@ static int stbtt__solve_cubic(float a, float b, float c, float* r)
    }
 }
 
+// LOCAL CHANGE begin: cubic curves in SDF generation, see LOCAL CHANGES at the top
+// Split the cubic curves of a shape (CFF fonts) into quadratic curves, the SDF distance and winding
+// code only handles lines and quadratic curves, cubics were ignored
+// Each cubic becomes STBTT__SDF_CUBIC_SPLITS quadratics with the same end points and end tangents
+#define STBTT__SDF_CUBIC_SPLITS 4
+static int stbtt__sdf_split_cubics(stbtt_vertex **vertices, int num_verts, void *userdata)
+{
+   stbtt_vertex *verts = *vertices, *out;
+   int i, k, cubics = 0, num_out = 0;
+
+   for (i=0; i < num_verts; ++i)
+      if (verts[i].type == STBTT_vcubic) ++cubics;
+   if (cubics == 0) return num_verts;
+
+   out = (stbtt_vertex *) STBTT_malloc((num_verts + cubics*(STBTT__SDF_CUBIC_SPLITS-1)) * sizeof(stbtt_vertex), userdata);
+   if (out == NULL) return num_verts;
+
+   for (i=0; i < num_verts; ++i) {
+      float p[4][2];
+      if (verts[i].type != STBTT_vcubic || i == 0) {
+         out[num_out++] = verts[i];
+         continue;
+      }
+      p[0][0] = verts[i-1].x; p[0][1] = verts[i-1].y;
+      p[1][0] = verts[i].cx;  p[1][1] = verts[i].cy;
+      p[2][0] = verts[i].cx1; p[2][1] = verts[i].cy1;
+      p[3][0] = verts[i].x;   p[3][1] = verts[i].y;
+      for (k=0; k < STBTT__SDF_CUBIC_SPLITS; ++k) {
+         float t0 = (float) k/STBTT__SDF_CUBIC_SPLITS, t1 = (float) (k+1)/STBTT__SDF_CUBIC_SPLITS, dt = t1 - t0;
+         float a[2], b[2], da[2], db[2], c[2];
+         int d;
+         for (d=0; d < 2; ++d) {
+            float u0 = 1-t0, u1 = 1-t1;
+            a[d] = u0*u0*u0*p[0][d] + 3*u0*u0*t0*p[1][d] + 3*u0*t0*t0*p[2][d] + t0*t0*t0*p[3][d];
+            b[d] = u1*u1*u1*p[0][d] + 3*u1*u1*t1*p[1][d] + 3*u1*t1*t1*p[2][d] + t1*t1*t1*p[3][d];
+            da[d] = 3*(u0*u0*(p[1][d]-p[0][d]) + 2*u0*t0*(p[2][d]-p[1][d]) + t0*t0*(p[3][d]-p[2][d]));
+            db[d] = 3*(u1*u1*(p[1][d]-p[0][d]) + 2*u1*t1*(p[2][d]-p[1][d]) + t1*t1*(p[3][d]-p[2][d]));
+            // Piece control points a + da*dt/3 and b - db*dt/3, averaged into one quadratic control point
+            c[d] = (3*((a[d] + da[d]*dt/3) + (b[d] - db[d]*dt/3)) - (a[d] + b[d]))/4;
+         }
+         if (k == STBTT__SDF_CUBIC_SPLITS-1) { b[0] = p[3][0]; b[1] = p[3][1]; }
+         stbtt_setvertex(&out[num_out], STBTT_vcurve, (stbtt_int32) STBTT_ifloor(b[0] + 0.5f), (stbtt_int32) STBTT_ifloor(b[1] + 0.5f),
+                         (stbtt_int32) STBTT_ifloor(c[0] + 0.5f), (stbtt_int32) STBTT_ifloor(c[1] + 0.5f));
+         ++num_out;
+      }
+   }
+
+   STBTT_free(verts, userdata);
+   *vertices = out;
+   return num_out;
+}
+// LOCAL CHANGE end
+
 STBTT_DEF unsigned char * stbtt_GetGlyphSDF(const stbtt_fontinfo *info, float scale, int glyph, int padding, unsigned char onedge_value, float pixel_dist_scale, int *width, int *height, int *xoff, int *yoff)
 {
    float scale_x = scale, scale_y = scale;
@@ -4610,6 +4670,7 @@ STBTT_DEF unsigned char * stbtt_GetGlyphSDF(const stbtt_fontinfo *info, float sc
       float *precompute;
       stbtt_vertex *verts;
       int num_verts = stbtt_GetGlyphShape(info, glyph, &verts);
+      num_verts = stbtt__sdf_split_cubics(&verts, num_verts, info->userdata);   // LOCAL CHANGE
       data = (unsigned char *) STBTT_malloc(w * h, info->userdata);
       precompute = (float *) STBTT_malloc(num_verts * sizeof(float), info->userdata);
 
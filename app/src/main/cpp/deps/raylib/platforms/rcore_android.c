@@ -62,6 +62,8 @@ typedef struct {
     struct android_poll_source *source; // Android events polling source
     bool appEnabled;                    // Flag to detect if app is active ** = true
     bool contextRebindRequired;         // Used to know context rebind required
+    bool redrawRequested;               // Input or window event received since last IsRedrawRequested() call
+    int eventWaitTimeout;               // Milliseconds PollInputEvents() blocks with event waiting enabled (-1: forever)
 
     // Display data
     EGLDisplay device;                  // Native display device (physical screen connection)
@@ -302,6 +304,20 @@ struct android_app *GetAndroidApp(void)
     return platform.app;
 }
 
+// NOTE: Declared in raymob.h, used for on-demand rendering along with EnableEventWaiting()
+void SetEventWaitTimeout(int milliseconds)
+{
+    platform.eventWaitTimeout = milliseconds;
+}
+
+// NOTE: Declared in raymob.h, the request is consumed by the call
+bool IsRedrawRequested(void)
+{
+    bool requested = platform.redrawRequested;
+    platform.redrawRequested = false;
+    return requested;
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition: Window and Graphics Device
 //----------------------------------------------------------------------------------
@@ -687,10 +703,16 @@ void PollInputEvents(void)
     int pollResult = 0;
     int pollEvents = 0;
 
-    // Poll Events (registered events) until we reach TIMEOUT which indicates there are no events left to poll
     // NOTE: Activity is paused if not enabled (platform.appEnabled)
-    while ((pollResult = ALooper_pollOnce(platform.appEnabled? 0 : -1, NULL, &pollEvents, (void**)&platform.source)) > ALOOPER_POLL_TIMEOUT)
+    // With event waiting enabled, block until the first event arrives or the timeout expires
+    int pollTimeout = platform.appEnabled? (CORE.Window.eventWaiting? platform.eventWaitTimeout : 0) : -1;
+
+    // Poll Events (registered events) until we reach TIMEOUT which indicates there are no events left to poll
+    while ((pollResult = ALooper_pollOnce(pollTimeout, NULL, &pollEvents, (void**)&platform.source)) > ALOOPER_POLL_TIMEOUT)
     {
+        // Remaining events are drained without blocking
+        if (platform.appEnabled) pollTimeout = 0;
+
         // Process this event
         if (platform.source != NULL) platform.source->process(platform.app, platform.source);
 
@@ -757,6 +779,7 @@ int InitPlatform(void)
     // Initialize input events system
     //----------------------------------------------------------------------------
     platform.app->onInputEvent = AndroidInputCallback;
+    platform.eventWaitTimeout = -1;     // Same as desktop platforms: wait until an event arrives
     //----------------------------------------------------------------------------
 
     // Initialize storage system
@@ -946,6 +969,17 @@ static int InitGraphicsDevice(void)
 // ANDROID: Process activity lifecycle commands
 static void AndroidCommandCallback(struct android_app *app, int32_t cmd)
 {
+    switch (cmd)
+    {
+        case APP_CMD_INIT_WINDOW:
+        case APP_CMD_GAINED_FOCUS:
+        case APP_CMD_CONFIG_CHANGED:
+        case APP_CMD_WINDOW_RESIZED:
+        case APP_CMD_WINDOW_REDRAW_NEEDED:
+        case APP_CMD_CONTENT_RECT_CHANGED: platform.redrawRequested = true; break;
+        default: break;
+    }
+
     switch (cmd)
     {
         case APP_CMD_START:
@@ -1131,6 +1165,8 @@ static int32_t AndroidInputCallback(struct android_app *app, AInputEvent *event)
     int type = AInputEvent_getType(event);
     int source = AInputEvent_getSource(event);
 
+    platform.redrawRequested = true;
+
     if (type == AINPUT_EVENT_TYPE_MOTION)
     {
         if (((source & AINPUT_SOURCE_JOYSTICK) == AINPUT_SOURCE_JOYSTICK) ||
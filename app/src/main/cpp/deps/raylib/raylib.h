@@ -312,6 +312,10 @@ typedef struct GlyphInfo {
     Image image;            // Character image data
 } GlyphInfo;
 
+// Opaque structs declaration
+// NOTE: Actual structs are defined internally in rtext module
+typedef struct rGlyphTable rGlyphTable;
+
 // Font, font texture and GlyphInfo array data
 typedef struct Font {
     int baseSize;           // Base size (default chars height)
@@ -320,8 +324,24 @@ typedef struct Font {
     Texture2D texture;      // Texture atlas containing the glyphs
     Rectangle *recs;        // Rectangles in texture for the glyphs
     GlyphInfo *glyphs;      // Glyphs info data
+    rGlyphTable *glyphTable; // Codepoint to glyph index lookup, built on font loading (NULL: linear search)
+    int type;               // Font type (FontType), FONT_SDF glyphs are drawn through the SDF shapes shader
 } Font;
 
+// TextLayout, text shaped once into glyph quads, drawn again without decoding it
+typedef struct TextLayout {
+    Font font;              // Font the text was shaped with
+    float fontSize;         // Font size the text was shaped at
+    float spacing;          // Characters spacing the text was shaped with
+    int lineSpacing;        // Line spacing the text was shaped with (SetTextLineSpacing())
+    char *text;             // Copy of the shaped text
+    int textCapacity;       // Bytes allocated for the text copy
+    int glyphCount;         // Number of glyph quads
+    int glyphCapacity;      // Glyph quads allocated
+    float *quads;           // Glyph quads, 8 floats each: x0, y0, x1, y1 (relative to text position), u0, v0, u1, v1
+    Vector2 size;           // Text size, as returned by MeasureTextEx()
+} TextLayout;
+
 // Camera, defines position/orientation in 3d space
 typedef struct Camera3D {
     Vector3 position;       // Camera position
@@ -890,7 +910,7 @@ typedef enum {
 typedef enum {
     FONT_DEFAULT = 0,               // Default font generation, anti-aliased
     FONT_BITMAP,                    // Bitmap font generation, no anti-aliasing
-    FONT_SDF                        // SDF font generation, requires external shader
+    FONT_SDF                        // SDF font generation, requires LoadShapesShaderSDF() shader
 } FontType;
 
 // Color blending modes (pre-defined)
@@ -1274,6 +1294,9 @@ RLAPI void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color);
 RLAPI void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color color);              // Draw rectangle with rounded edges
 RLAPI void DrawRectangleRoundedLines(Rectangle rec, float roundness, int segments, Color color);         // Draw rectangle lines with rounded edges
 RLAPI void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, float lineThick, Color color); // Draw rectangle with rounded edges outline
+RLAPI Shader LoadShapesShaderSDF(void);                                                            // Load shader required by SDF shapes and SDF fonts, it also draws regular shapes, textures and text
+RLAPI void DrawRectangleRoundedSDF(Rectangle rec, float roundness, Color color);                   // Draw rectangle with rounded edges as a single SDF quad (requires SDF shapes shader)
+RLAPI void DrawRectangleRoundedLinesSDF(Rectangle rec, float roundness, float lineThick, Color color); // Draw rectangle with rounded edges outline as a single SDF quad (requires SDF shapes shader)
 RLAPI void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color);                                // Draw a color-filled triangle (vertex in counter-clockwise order!)
 RLAPI void DrawTriangleLines(Vector2 v1, Vector2 v2, Vector2 v3, Color color);                           // Draw triangle outline (vertex in counter-clockwise order!)
 RLAPI void DrawTriangleFan(const Vector2 *points, int pointCount, Color color);                          // Draw a triangle fan defined by points (first vertex is the center)
@@ -1462,12 +1485,15 @@ RLAPI Font LoadFont(const char *fileName);
 RLAPI Font LoadFontEx(const char *fileName, int fontSize, int *codepoints, int codepointCount); // Load font from file with extended parameters, use NULL for codepoints and 0 for codepointCount to load the default character set, font size is provided in pixels height
 RLAPI Font LoadFontFromImage(Image image, Color key, int firstChar);                        // Load font from Image (XNA style)
 RLAPI Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int dataSize, int fontSize, int *codepoints, int codepointCount); // Load font from memory buffer, fileType refers to extension: i.e. '.ttf'
+RLAPI Font LoadFontSDF(const char *fileName, int fontSize, int *codepoints, int codepointCount); // Load TTF font as signed distance field atlas, text drawn at any size through the SDF shapes shader
 RLAPI bool IsFontValid(Font font);                                                          // Check if a font is valid (font data loaded, WARNING: GPU texture not checked)
 RLAPI GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSize, int *codepoints, int codepointCount, int type); // Load font data for further use
 RLAPI Image GenImageFontAtlas(const GlyphInfo *glyphs, Rectangle **glyphRecs, int glyphCount, int fontSize, int padding, int packMethod); // Generate image font atlas using chars info
 RLAPI void UnloadFontData(GlyphInfo *glyphs, int glyphCount);                               // Unload font chars info data (RAM)
+RLAPI void SetFontLoadThreads(int threads);                                                 // Set threads rasterizing glyphs on font loading, 0 for one per core (default)
 RLAPI void UnloadFont(Font font);                                                           // Unload font from GPU memory (VRAM)
 RLAPI bool ExportFontAsCode(Font font, const char *fileName);                               // Export font as code file, returns true on success
+RLAPI bool ExportFontBaked(Font font, Image atlas, bool compressed, const char *fileName);  // Export font glyphs and atlas image as baked font file (.rfnt), returns true on success
 
 // Text drawing functions
 RLAPI void DrawFPS(int posX, int posY);                                                     // Draw current FPS
@@ -1477,6 +1503,12 @@ RLAPI void DrawTextPro(Font font, const char *text, Vector2 position, Vector2 or
 RLAPI void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint); // Draw one character (codepoint)
 RLAPI void DrawTextCodepoints(Font font, const int *codepoints, int codepointCount, Vector2 position, float fontSize, float spacing, Color tint); // Draw multiple character (codepoint)
 
+// Text layout functions
+RLAPI TextLayout LoadTextLayout(Font font, const char *text, float fontSize, float spacing); // Load text layout, text shaped into glyph quads
+RLAPI bool UpdateTextLayout(TextLayout *layout, Font font, const char *text, float fontSize, float spacing); // Update text layout, shaped again only if text, font or size changed (returns true if it was)
+RLAPI void UnloadTextLayout(TextLayout layout);                                             // Unload text layout
+RLAPI void DrawTextLayout(TextLayout layout, Vector2 position, Color tint);                 // Draw text layout, all glyph quads submitted in a single batch
+
 // Text font info functions
 RLAPI void SetTextLineSpacing(int spacing);                                                 // Set vertical line spacing when drawing with line-breaks
 RLAPI int MeasureText(const char *text, int fontSize);                                      // Measure string width for default font
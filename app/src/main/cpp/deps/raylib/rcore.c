@@ -110,9 +110,19 @@
 #include <time.h>                   // Required for: time() [Used in InitTimer()]
 #include <math.h>                   // Required for: tan() [Used in BeginMode3D()], atan2f() [Used in LoadVrStereoConfig()]
 
+#if defined(SUPPORT_ALLOC_TRACKING)
+    #undef ALLOC_MODULE
+    #define ALLOC_MODULE ALLOC_MODULE_RLGL  // Attribute rlgl allocations to rlgl, not rcore
+#endif
+
 #define RLGL_IMPLEMENTATION
 #include "rlgl.h"                   // OpenGL abstraction layer to OpenGL 1.1, 3.3+ or ES2
 
+#if defined(SUPPORT_ALLOC_TRACKING)
+    #undef ALLOC_MODULE
+    #define ALLOC_MODULE ALLOC_MODULE_RCORE
+#endif
+
 #define RAYMATH_IMPLEMENTATION
 #include "raymath.h"                // Vector2, Vector3, Quaternion and Matrix functionality
 
@@ -58,6 +58,7 @@
 #include <math.h>       // Required for: sinf(), asinf(), cosf(), acosf(), sqrtf(), fabsf()
 #include <float.h>      // Required for: FLT_EPSILON
 #include <stdlib.h>     // Required for: RL_FREE
+#include <string.h>     // Required for: strlen(), strcat()
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -70,11 +71,28 @@
 #ifndef SPLINE_SEGMENT_DIVISIONS
     #define SPLINE_SEGMENT_DIVISIONS      24      // Spline segment divisions
 #endif
+#ifndef ROUNDED_RECT_CACHE_SIZE
+    #define ROUNDED_RECT_CACHE_SIZE       16      // Rounded rectangle corner tables kept in cache
+#endif
+#ifndef ROUNDED_RECT_CACHE_MAX_SEGMENTS
+    #define ROUNDED_RECT_CACHE_MAX_SEGMENTS 32    // Corners with more segments are not cached
+#endif
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// Not here...
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+// Precomputed corner arcs for rounded rectangles, points are relative to the corner center
+// NOTE: Corners are ordered as drawn: upper left, upper right, lower right, lower left
+typedef struct RoundedCorners {
+    float innerRadius;          // Key: arc radius (fill) or inner radius (outline)
+    float outerRadius;          // Key: same as innerRadius for fills, outer radius for outlines
+    int requestedSegments;      // Key: segments requested by the caller (<4 means automatic)
+    int segments;               // Segments per corner actually used
+    Vector2 inner[4][ROUNDED_RECT_CACHE_MAX_SEGMENTS + 1];
+    Vector2 outer[4][ROUNDED_RECT_CACHE_MAX_SEGMENTS + 1];
+} RoundedCorners;
+#endif
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -82,10 +100,19 @@
 static Texture2D texShapes = { 1, 1, 1, 1, 7 };                // Texture used on shapes drawing (white pixel loaded by rlgl)
 static Rectangle texShapesRec = { 0.0f, 0.0f, 1.0f, 1.0f };    // Texture source rectangle used on shapes drawing
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+static RoundedCorners roundedCornersCache[ROUNDED_RECT_CACHE_SIZE] = { 0 };    // Rounded rectangle corner arcs cache
+static int roundedCornersCount = 0;         // Number of valid entries in cache
+static int roundedCornersNext = 0;          // Next entry to replace when cache is full
+#endif
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
 static float EaseCubicInOut(float t, float b, float c, float d);    // Cubic easing
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+static const RoundedCorners *GetRoundedCorners(float innerRadius, float outerRadius, int segments, float segmentsDivisor); // Get cached corner arcs
+#endif
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -896,6 +923,12 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
     float radius = (rec.width > rec.height)? (rec.height*roundness)/2 : (rec.width*roundness)/2;
     if (radius <= 0.0f) return;
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+    // Corner arcs are reused between calls with the same radius and segments
+    const RoundedCorners *corners = GetRoundedCorners(radius, radius, segments, 4.0f);
+    if (corners != NULL) segments = corners->segments;
+#endif
+
     // Calculate number of segments to use for the corners
     if (segments < 4)
     {
@@ -946,6 +979,47 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
             float angle = angles[k];
             const Vector2 center = centers[k];
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+            if (corners != NULL)
+            {
+                const Vector2 *arc = corners->inner[k];
+
+                for (int i = 0; i < segments/2; i++)
+                {
+                    rlColor4ub(color.r, color.g, color.b, color.a);
+                    rlTexCoord2f(shapeRect.x/texShapes.width, shapeRect.y/texShapes.height);
+                    rlVertex2f(center.x, center.y);
+
+                    rlTexCoord2f((shapeRect.x + shapeRect.width)/texShapes.width, shapeRect.y/texShapes.height);
+                    rlVertex2f(center.x + arc[i*2 + 2].x, center.y + arc[i*2 + 2].y);
+
+                    rlTexCoord2f((shapeRect.x + shapeRect.width)/texShapes.width, (shapeRect.y + shapeRect.height)/texShapes.height);
+                    rlVertex2f(center.x + arc[i*2 + 1].x, center.y + arc[i*2 + 1].y);
+
+                    rlTexCoord2f(shapeRect.x/texShapes.width, (shapeRect.y + shapeRect.height)/texShapes.height);
+                    rlVertex2f(center.x + arc[i*2].x, center.y + arc[i*2].y);
+                }
+
+                if (segments%2)
+                {
+                    rlColor4ub(color.r, color.g, color.b, color.a);
+                    rlTexCoord2f(shapeRect.x/texShapes.width, shapeRect.y/texShapes.height);
+                    rlVertex2f(center.x, center.y);
+
+                    rlTexCoord2f((shapeRect.x + shapeRect.width)/texShapes.width, (shapeRect.y + shapeRect.height)/texShapes.height);
+                    rlVertex2f(center.x + arc[segments].x, center.y + arc[segments].y);
+
+                    rlTexCoord2f(shapeRect.x/texShapes.width, (shapeRect.y + shapeRect.height)/texShapes.height);
+                    rlVertex2f(center.x + arc[segments - 1].x, center.y + arc[segments - 1].y);
+
+                    rlTexCoord2f((shapeRect.x + shapeRect.width)/texShapes.width, shapeRect.y/texShapes.height);
+                    rlVertex2f(center.x, center.y);
+                }
+
+                continue;
+            }
+#endif
+
             // NOTE: Every QUAD actually represents two segments
             for (int i = 0; i < segments/2; i++)
             {
@@ -1048,6 +1122,24 @@ void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color co
         {
             float angle = angles[k];
             const Vector2 center = centers[k];
+
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+            if (corners != NULL)
+            {
+                const Vector2 *arc = corners->inner[k];
+
+                for (int i = 0; i < segments; i++)
+                {
+                    rlColor4ub(color.r, color.g, color.b, color.a);
+                    rlVertex2f(center.x, center.y);
+                    rlVertex2f(center.x + arc[i + 1].x, center.y + arc[i + 1].y);
+                    rlVertex2f(center.x + arc[i].x, center.y + arc[i].y);
+                }
+
+                continue;
+            }
+#endif
+
             for (int i = 0; i < segments; i++)
             {
                 rlColor4ub(color.r, color.g, color.b, color.a);
@@ -1131,6 +1223,12 @@ void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, f
     float radius = (rec.width > rec.height)? (rec.height*roundness)/2 : (rec.width*roundness)/2;
     if (radius <= 0.0f) return;
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+    // Corner arcs are reused between calls with the same radius, thickness and segments
+    const RoundedCorners *corners = GetRoundedCorners(radius, radius + lineThick, segments, 2.0f);
+    if (corners != NULL) segments = corners->segments;
+#endif
+
     // Calculate number of segments to use for the corners
     if (segments < 4)
     {
@@ -1189,6 +1287,34 @@ void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, f
             {
                 float angle = angles[k];
                 const Vector2 center = centers[k];
+
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+                if (corners != NULL)
+                {
+                    const Vector2 *inner = corners->inner[k];
+                    const Vector2 *outer = corners->outer[k];
+
+                    for (int i = 0; i < segments; i++)
+                    {
+                        rlColor4ub(color.r, color.g, color.b, color.a);
+
+                        rlTexCoord2f(shapeRect.x/texShapes.width, shapeRect.y/texShapes.height);
+                        rlVertex2f(center.x + inner[i].x, center.y + inner[i].y);
+
+                        rlTexCoord2f((shapeRect.x + shapeRect.width)/texShapes.width, shapeRect.y/texShapes.height);
+                        rlVertex2f(center.x + inner[i + 1].x, center.y + inner[i + 1].y);
+
+                        rlTexCoord2f((shapeRect.x + shapeRect.width)/texShapes.width, (shapeRect.y + shapeRect.height)/texShapes.height);
+                        rlVertex2f(center.x + outer[i + 1].x, center.y + outer[i + 1].y);
+
+                        rlTexCoord2f(shapeRect.x/texShapes.width, (shapeRect.y + shapeRect.height)/texShapes.height);
+                        rlVertex2f(center.x + outer[i].x, center.y + outer[i].y);
+                    }
+
+                    continue;
+                }
+#endif
+
                 for (int i = 0; i < segments; i++)
                 {
                     rlColor4ub(color.r, color.g, color.b, color.a);
@@ -1264,6 +1390,29 @@ void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, f
                 float angle = angles[k];
                 const Vector2 center = centers[k];
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+                if (corners != NULL)
+                {
+                    const Vector2 *inner = corners->inner[k];
+                    const Vector2 *outer = corners->outer[k];
+
+                    for (int i = 0; i < segments; i++)
+                    {
+                        rlColor4ub(color.r, color.g, color.b, color.a);
+
+                        rlVertex2f(center.x + inner[i].x, center.y + inner[i].y);
+                        rlVertex2f(center.x + inner[i + 1].x, center.y + inner[i + 1].y);
+                        rlVertex2f(center.x + outer[i].x, center.y + outer[i].y);
+
+                        rlVertex2f(center.x + inner[i + 1].x, center.y + inner[i + 1].y);
+                        rlVertex2f(center.x + outer[i + 1].x, center.y + outer[i + 1].y);
+                        rlVertex2f(center.x + outer[i].x, center.y + outer[i].y);
+                    }
+
+                    continue;
+                }
+#endif
+
                 for (int i = 0; i < segments; i++)
                 {
                     rlColor4ub(color.r, color.g, color.b, color.a);
@@ -1329,6 +1478,22 @@ void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, f
                 float angle = angles[k];
                 const Vector2 center = centers[k];
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+                if (corners != NULL)
+                {
+                    const Vector2 *outer = corners->outer[k];
+
+                    for (int i = 0; i < segments; i++)
+                    {
+                        rlColor4ub(color.r, color.g, color.b, color.a);
+                        rlVertex2f(center.x + outer[i].x, center.y + outer[i].y);
+                        rlVertex2f(center.x + outer[i + 1].x, center.y + outer[i + 1].y);
+                    }
+
+                    continue;
+                }
+#endif
+
                 for (int i = 0; i < segments; i++)
                 {
                     rlColor4ub(color.r, color.g, color.b, color.a);
@@ -1350,6 +1515,173 @@ void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, f
     }
 }
 
+// Load shader used to draw rounded rectangles and SDF font glyphs as signed distance fields
+// NOTE: Regular geometry (normal z >= 0) goes through the same path as the default shader,
+// so the shader can stay active for a whole layer and SDF quads batch with any other shape or text
+Shader LoadShapesShaderSDF(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    const char *vsCode =
+        "#version 330                       \n"
+        "in vec3 vertexPosition;            \n"
+        "in vec2 vertexTexCoord;            \n"
+        "in vec3 vertexNormal;              \n"
+        "in vec4 vertexColor;               \n"
+        "out vec2 fragTexCoord;             \n"
+        "out vec4 fragColor;                \n"
+        "out vec4 fragShape;                \n"
+        "out float fragSDF;                 \n"
+        "uniform mat4 mvp;                  \n";
+    const char *fsCode =
+        "#version 330                       \n"
+        "in vec2 fragTexCoord;              \n"
+        "in vec4 fragColor;                 \n"
+        "in vec4 fragShape;                 \n"
+        "in float fragSDF;                  \n"
+        "out vec4 finalColor;               \n"
+        "uniform sampler2D texture0;        \n"
+        "uniform vec4 colDiffuse;           \n"
+        "#define gl_FragColor finalColor    \n"
+        "#define texture2D texture          \n";
+#else
+    const char *vsCode =
+        "#version 100                       \n"
+        "precision highp float;             \n"
+        "attribute vec3 vertexPosition;     \n"
+        "attribute vec2 vertexTexCoord;     \n"
+        "attribute vec3 vertexNormal;       \n"
+        "attribute vec4 vertexColor;        \n"
+        "varying vec2 fragTexCoord;         \n"
+        "varying vec4 fragColor;            \n"
+        "varying vec4 fragShape;            \n"
+        "varying float fragSDF;             \n"
+        "uniform mat4 mvp;                  \n";
+    const char *fsCode =
+        "#version 100                       \n"
+        "#ifdef GL_FRAGMENT_PRECISION_HIGH  \n"
+        "precision highp float;             \n"
+        "#else                              \n"
+        "precision mediump float;           \n"
+        "#endif                             \n"
+        "varying vec2 fragTexCoord;         \n"
+        "varying vec4 fragColor;            \n"
+        "varying vec4 fragShape;            \n"
+        "varying float fragSDF;             \n"
+        "uniform sampler2D texture0;        \n"
+        "uniform vec4 colDiffuse;           \n";
+#endif
+    // NOTE: For SDF quads, texcoords are the position relative to the rectangle center and
+    // the normal is normalize(radius, lineThick, -1), constant over the quad
+    // For SDF glyph quads (rtext, FONT_SDF), the normal is normalize(pixelDistance, 0, 1): distance
+    // values are in the atlas alpha with the edge at 128/255, regular geometry has normal (0, 0, 1)
+    const char *vsMain =
+        "void main()                                                                \n"
+        "{                                                                          \n"
+        "    fragTexCoord = vertexTexCoord;                                         \n"
+        "    fragColor = vertexColor;                                               \n"
+        "    float glyph = length(vertexNormal.xy);                                 \n"
+        "    fragSDF = (vertexNormal.z < 0.0)? 1.0 : (((vertexNormal.z > 0.0) && (glyph > 0.0))? 2.0 : 0.0); \n"
+        "    vec2 params = (vertexNormal.z < 0.0)? -vertexNormal.xy/vertexNormal.z : vec2(0.0); \n"
+        "    fragShape = vec4(abs(vertexTexCoord) - params.y - 1.0, params.x, params.y); \n"
+        "    if (fragSDF > 1.5) fragShape = vec4(0.0, 0.0, 128.0/255.0, glyph/vertexNormal.z); \n"
+        "    gl_Position = mvp*vec4(vertexPosition, 1.0);                           \n"
+        "}                                                                          \n";
+    const char *fsMain =
+        "void main()                                                                \n"
+        "{                                                                          \n"
+        "    if (fragSDF < 0.5)                                                     \n"
+        "    {                                                                      \n"
+        "        gl_FragColor = texture2D(texture0, fragTexCoord)*colDiffuse*fragColor; \n"
+        "        return;                                                            \n"
+        "    }                                                                      \n"
+        "    if (fragSDF > 1.5)                                                     \n"
+        "    {                                                                      \n"
+        "        float distance = texture2D(texture0, fragTexCoord).a;              \n"
+        "        float coverage = clamp((distance - fragShape.z)/fragShape.w + 0.5, 0.0, 1.0); \n"
+        "        gl_FragColor = vec4(fragColor.rgb, fragColor.a*coverage)*colDiffuse; \n"
+        "        return;                                                            \n"
+        "    }                                                                      \n"
+        "    vec2 q = abs(fragTexCoord) - fragShape.xy + fragShape.z;               \n"
+        "    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - fragShape.z; \n"
+        "    float coverage = clamp(0.5 - d, 0.0, 1.0);                             \n"
+        "    if (fragShape.w > 0.0) coverage = clamp(0.5 + d, 0.0, 1.0)*clamp(0.5 - d + fragShape.w, 0.0, 1.0); \n"
+        "    gl_FragColor = vec4(fragColor.rgb, fragColor.a*coverage)*colDiffuse;   \n"
+        "}                                                                          \n";
+
+    char *vs = (char *)RL_CALLOC(strlen(vsCode) + strlen(vsMain) + 1, 1);
+    char *fs = (char *)RL_CALLOC(strlen(fsCode) + strlen(fsMain) + 1, 1);
+    strcat(strcat(vs, vsCode), vsMain);
+    strcat(strcat(fs, fsCode), fsMain);
+
+    Shader shader = LoadShaderFromMemory(vs, fs);
+
+    RL_FREE(vs);
+    RL_FREE(fs);
+
+    return shader;
+}
+
+// Draw one quad covering a rounded rectangle (plus outline and antialiasing margin)
+// NOTE: Shape parameters are passed through texcoords and normal, so it does not work
+// with rotations applied through rlRotatef() on the current transform
+static void DrawRoundedQuadSDF(Rectangle rec, float roundness, float lineThick, Color color)
+{
+    if (roundness < 0.0f) roundness = 0.0f;
+    if (roundness >= 1.0f) roundness = 1.0f;
+    if (lineThick < 0.0f) lineThick = 0.0f;
+
+    float radius = (rec.width > rec.height)? (rec.height*roundness)/2 : (rec.width*roundness)/2;
+
+    // Outline is drawn outside the rectangle, 1 pixel margin for antialiasing
+    float halfWidth = rec.width/2 + lineThick + 1.0f;
+    float halfHeight = rec.height/2 + lineThick + 1.0f;
+    Vector2 center = { rec.x + rec.width/2, rec.y + rec.height/2 };
+
+    rlSetTexture(GetShapesTexture().id);
+
+    rlBegin(RL_QUADS);
+
+        rlNormal3f(radius, lineThick, -1.0f);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+
+        rlTexCoord2f(-halfWidth, -halfHeight);
+        rlVertex2f(center.x - halfWidth, center.y - halfHeight);
+
+        rlTexCoord2f(-halfWidth, halfHeight);
+        rlVertex2f(center.x - halfWidth, center.y + halfHeight);
+
+        rlTexCoord2f(halfWidth, halfHeight);
+        rlVertex2f(center.x + halfWidth, center.y + halfHeight);
+
+        rlTexCoord2f(halfWidth, -halfHeight);
+        rlVertex2f(center.x + halfWidth, center.y - halfHeight);
+
+        // Restore regular geometry normal for the following shapes
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    rlEnd();
+
+    rlSetTexture(0);
+}
+
+// Draw rectangle with rounded edges as a single quad, edges are antialiased by the SDF shapes shader
+// NOTE: Shader returned by LoadShapesShaderSDF() must be active (BeginShaderMode())
+void DrawRectangleRoundedSDF(Rectangle rec, float roundness, Color color)
+{
+    if ((rec.width < 1) || (rec.height < 1)) return;
+
+    DrawRoundedQuadSDF(rec, roundness, 0.0f, color);
+}
+
+// Draw rectangle with rounded edges outline as a single quad, outline is drawn outside rec like DrawRectangleRoundedLinesEx()
+// NOTE: Shader returned by LoadShapesShaderSDF() must be active (BeginShaderMode())
+void DrawRectangleRoundedLinesSDF(Rectangle rec, float roundness, float lineThick, Color color)
+{
+    if (lineThick <= 0.0f) return;
+
+    DrawRoundedQuadSDF(rec, roundness, lineThick, color);
+}
+
 // Draw a triangle
 // NOTE: Vertex must be provided in counter-clockwise order
 void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color)
@@ -2411,4 +2743,63 @@ static float EaseCubicInOut(float t, float b, float c, float d)
     return result;
 }
 
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+// Get corner arcs for a rounded rectangle, computing and caching them on first use
+// NOTE: segmentsDivisor matches the automatic segments formula of the caller (4 for fills, 2 for outlines),
+// returns NULL if the corners need more than ROUNDED_RECT_CACHE_MAX_SEGMENTS segments
+static const RoundedCorners *GetRoundedCorners(float innerRadius, float outerRadius, int segments, float segmentsDivisor)
+{
+    for (int i = 0; i < roundedCornersCount; i++)
+    {
+        const RoundedCorners *entry = &roundedCornersCache[i];
+        if ((entry->innerRadius == innerRadius) && (entry->outerRadius == outerRadius) && (entry->requestedSegments == segments)) return entry;
+    }
+
+    int requestedSegments = segments;
+
+    // Calculate number of segments to use for the corners
+    if (segments < 4)
+    {
+        // Calculate the maximum angle between segments based on the error rate (usually 0.5f)
+        // NOTE: Radius used is the one callers use, the inner radius
+        float th = acosf(2*powf(1 - SMOOTH_CIRCLE_ERROR_RATE/innerRadius, 2) - 1);
+        segments = (int)(ceilf(2*PI/th)/segmentsDivisor);
+        if (segments <= 0) segments = 4;
+    }
+
+    if (segments > ROUNDED_RECT_CACHE_MAX_SEGMENTS) return NULL;
+
+    RoundedCorners *entry = NULL;
+    if (roundedCornersCount < ROUNDED_RECT_CACHE_SIZE) entry = &roundedCornersCache[roundedCornersCount++];
+    else
+    {
+        entry = &roundedCornersCache[roundedCornersNext];
+        roundedCornersNext = (roundedCornersNext + 1)%ROUNDED_RECT_CACHE_SIZE;
+    }
+
+    entry->innerRadius = innerRadius;
+    entry->outerRadius = outerRadius;
+    entry->requestedSegments = requestedSegments;
+    entry->segments = segments;
+
+    const float angles[4] = { 180.0f, 270.0f, 0.0f, 90.0f };
+    float stepLength = 90.0f/(float)segments;
+
+    for (int k = 0; k < 4; k++)
+    {
+        for (int i = 0; i <= segments; i++)
+        {
+            float angle = DEG2RAD*(angles[k] + stepLength*i);
+            float c = cosf(angle);
+            float s = sinf(angle);
+
+            entry->inner[k][i] = (Vector2){ c*innerRadius, s*innerRadius };
+            entry->outer[k][i] = (Vector2){ c*outerRadius, s*outerRadius };
+        }
+    }
+
+    return entry;
+}
+#endif
+
 #endif      // SUPPORT_MODULE_RSHAPES
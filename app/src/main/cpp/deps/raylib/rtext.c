@@ -16,11 +16,27 @@
 *           Selected desired fileformats to be supported for loading. Some of those formats are
 *           supported by default, to remove support, just comment unrequired #define in this module
 *
+*       #define SUPPORT_FILEFORMAT_RFNT
+*           Baked fonts (.rfnt) written by ExportFontBaked() are loaded as stored: glyph metrics, recs
+*           and atlas pixels, DEFLATE compressed or not, uploaded without any rasterization
+*
 *       #define SUPPORT_FONT_ATLAS_WHITE_REC
 *           On font atlas image generation [GenImageFontAtlas()], add a 3x3 pixels white rectangle
 *           at the bottom-right corner of the atlas. It can be useful to for shapes drawing, to allow
 *           drawing text and shapes with a single draw call [SetShapesTexture()].
 *
+*       #define SUPPORT_GLYPH_INDEX_TABLE
+*           Fonts loaded by this module get a codepoint to glyph index table, GetGlyphIndex() is a
+*           direct lookup instead of a linear search, whatever the number of glyphs.
+*
+*       #define SUPPORT_FONT_LOAD_THREADS
+*           LoadFontData() rasterizes TTF glyphs over several threads (pthreads), up to one per core
+*           and FONT_LOAD_MAX_THREADS, SetFontLoadThreads() overrides the count.
+*
+*       #define SUPPORT_TEXT_LAYOUT_CACHE
+*           DrawTextEx() and MeasureTextEx() keep the TextLayout of the last TEXT_LAYOUT_CACHE_SIZE
+*           strings, a string drawn again is submitted from its cached glyph quads.
+*
 *       #define TEXTSPLIT_MAX_TEXT_BUFFER_LENGTH
 *           TextSplit() function static buffer max size
 *
@@ -30,6 +46,7 @@
 *   DEPENDENCIES:
 *       stb_truetype  - Load TTF file and rasterize characters data
 *       stb_rect_pack - Rectangles packing algorithms, required for font atlas generation
+*       sinfl/sdefl   - Baked font atlas decompression/compression (implemented in rcore)
 *
 *
 *   LICENSE: zlib/libpng
@@ -71,6 +88,18 @@
 #include <stdarg.h>         // Required for: va_list, va_start(), vsprintf(), va_end() [Used in TextFormat()]
 #include <ctype.h>          // Required for: toupper(), tolower() [Used in TextToUpper(), TextToLower()]
 
+#if defined(SUPPORT_FONT_LOAD_THREADS)
+    #include <pthread.h>    // Required for: pthread_create(), pthread_join() [Used in LoadFontData()]
+    #include <unistd.h>     // Required for: sysconf() [Used in LoadFontData()]
+#endif
+
+#if defined(SUPPORT_COMPRESSION_API)
+    #include "external/sdefl.h"     // Required for: sdeflate() [Used in ExportFontBaked()]
+    #if defined(SUPPORT_FILEFORMAT_RFNT)
+        #include "external/sinfl.h" // Required for: sinflate() [Used in LoadFontBaked()]
+    #endif
+#endif
+
 #if defined(SUPPORT_FILEFORMAT_TTF) || defined(SUPPORT_FILEFORMAT_BDF)
     #if defined(__GNUC__) // GCC and Clang
         #pragma GCC diagnostic push
@@ -97,6 +126,12 @@
     #define STB_TRUETYPE_IMPLEMENTATION
     #include "external/stb_truetype.h"      // Required for: ttf font data reading
 
+    // NOTE: FONT_SDF generation relies on the local stb_truetype change splitting cubic curves,
+    // without it CFF fonts (Cubano.ttf) get SDF glyphs with their curved edges missing
+    #if !defined(STBTT__SDF_CUBIC_SPLITS)
+        #error "external/stb_truetype.h lacks the local cubic curve change for SDF generation, see LOCAL CHANGES in it"
+    #endif
+
     #if defined(__GNUC__) // GCC and Clang
         #pragma GCC diagnostic pop
     #endif
@@ -116,10 +151,92 @@
     #define MAX_TEXTSPLIT_COUNT                  128        // Maximum number of substrings to split: TextSplit()
 #endif
 
+#ifndef FONT_LOAD_MAX_THREADS
+    #define FONT_LOAD_MAX_THREADS                8        // Maximum threads rasterizing glyphs in LoadFontData()
+#endif
+#ifndef FONT_LOAD_MIN_GLYPHS_PER_THREAD
+    #define FONT_LOAD_MIN_GLYPHS_PER_THREAD     16        // Fewer glyphs per thread are not worth a thread start
+#endif
+#ifndef TEXT_LAYOUT_CACHE_SIZE
+    #define TEXT_LAYOUT_CACHE_SIZE               8        // Text layouts kept by DrawTextEx() and MeasureTextEx()
+#endif
+#ifndef TEXT_LAYOUT_CACHE_MAX_LENGTH
+    #define TEXT_LAYOUT_CACHE_MAX_LENGTH       256        // Longer strings are not cached
+#endif
+#ifndef TEXT_LAYOUT_MIN_CAPACITY
+    #define TEXT_LAYOUT_MIN_CAPACITY            32        // Text bytes and glyph quads allocated at least by a layout
+#endif
+#ifndef GLYPH_TABLE_PAGE_SIZE
+    #define GLYPH_TABLE_PAGE_SIZE              256        // Codepoints per page of the glyph index table
+#endif
+
+// NOTE: Using some SDF generation default values,
+// trades off precision with ability to handle *smaller* sizes
+#ifndef FONT_SDF_CHAR_PADDING
+    #define FONT_SDF_CHAR_PADDING                4        // SDF font generation char padding
+#endif
+#ifndef FONT_SDF_ON_EDGE_VALUE
+    #define FONT_SDF_ON_EDGE_VALUE             128        // SDF font generation on edge value (128 expected by LoadShapesShaderSDF())
+#endif
+#ifndef FONT_SDF_PIXEL_DIST_SCALE
+    #define FONT_SDF_PIXEL_DIST_SCALE        64.0f        // SDF font generation pixel distance scale
+#endif
+
+#define BAKED_FONT_VERSION                       2        // Baked font file (.rfnt) version, see BakedFontHeader
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-//...
+// Glyph rasterization job of LoadFontData(), shared by its threads
+typedef struct FontLoadJob {
+    const unsigned char *fileData;  // TTF data, read-only
+    const int *codepoints;          // Codepoints to rasterize
+    GlyphInfo *glyphs;              // Output, one slot per codepoint
+    int glyphCount;                 // Number of codepoints
+    int fontSize;                   // Font size in pixels
+    int type;                       // Font type: FONT_DEFAULT, FONT_BITMAP, FONT_SDF
+    float scaleFactor;              // stb_truetype scale for fontSize
+    int ascent;                     // Font ascent (unscaled)
+    int nextGlyph;                  // Next glyph to rasterize, taken atomically
+} FontLoadJob;
+
+// Baked font file (.rfnt) header, native byte order (little endian on all raylib platforms)
+// NOTE: File layout: BakedFontHeader | BakedGlyph[glyphCount] | atlas pixel data [atlasDataSize]
+typedef struct BakedFontHeader {
+    char id[4];                 // File identifier: "rFNT"
+    int version;                // BAKED_FONT_VERSION
+    int baseSize;               // Base size (default chars height)
+    int glyphCount;             // Number of glyph characters
+    int glyphPadding;           // Padding around the glyph characters
+    int type;                   // Font type (FontType): FONT_SDF atlases hold distance values
+    int atlasWidth;             // Atlas image width
+    int atlasHeight;            // Atlas image height
+    int atlasFormat;            // Atlas pixel format (PixelFormat type)
+    int atlasCompressed;        // Atlas pixel data is DEFLATE compressed
+    int atlasDataSize;          // Atlas pixel data size in the file
+} BakedFontHeader;
+
+// Baked font file (.rfnt) glyph, GlyphInfo without the image and its atlas rectangle
+typedef struct BakedGlyph {
+    int value;                  // Character value (Unicode)
+    int offsetX;                // Character offset X when drawing
+    int offsetY;                // Character offset Y when drawing
+    int advanceX;               // Character advance position X
+    Rectangle rec;              // Character rectangle in the atlas
+} BakedGlyph;
+
+// Codepoint to glyph index lookup table, one per loaded font
+// NOTE: BMP codepoints go through a two-level table where only the pages holding glyphs are
+// allocated (ASCII, Latin-Extended and Cyrillic are 4 pages), codepoints out of the BMP
+// (and invalid ones) go to a small open addressing hash table
+struct rGlyphTable {
+    int fallback;               // Glyph index returned for missing codepoints: '?' or 0, like the linear search
+    unsigned short pages[0x10000/GLYPH_TABLE_PAGE_SIZE]; // Page position + 1 in entries, 0 for pages without glyphs
+    int *entries;               // Glyph index per codepoint of the allocated pages, -1 if not in the font
+    int hashSize;               // Hash table size, power of two, 0 when all the glyphs are in the BMP
+    int *hashKeys;              // Codepoints
+    int *hashValues;            // Glyph indices, -1 for empty slots
+};
 
 //----------------------------------------------------------------------------------
 // Global variables
@@ -131,6 +248,11 @@ extern bool isGpuReady;
 static Font defaultFont = { 0 };
 #endif
 
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+static TextLayout textLayoutCache[TEXT_LAYOUT_CACHE_SIZE] = { 0 };    // Layouts of the last strings drawn or measured
+static int textLayoutCacheNext = 0;             // Next entry to replace
+#endif
+
 //----------------------------------------------------------------------------------
 // Other Modules Functions Declaration (required by text)
 //----------------------------------------------------------------------------------
@@ -142,10 +264,38 @@ static Font defaultFont = { 0 };
 #if defined(SUPPORT_FILEFORMAT_FNT)
 static Font LoadBMFont(const char *fileName);   // Load a BMFont file (AngelCode font file)
 #endif
+#if defined(SUPPORT_FILEFORMAT_RFNT)
+static Font LoadFontBaked(const unsigned char *fileData, int dataSize); // Load a baked font file (.rfnt) from memory
+#endif
 #if defined(SUPPORT_FILEFORMAT_BDF)
 static GlyphInfo *LoadFontDataBDF(const unsigned char *fileData, int dataSize, int *codepoints, int codepointCount, int *outFontSize);
 #endif
 static int textLineSpacing = 2;                 // Text vertical line spacing in pixels (between lines)
+static int fontLoadThreads = 0;                 // Threads rasterizing glyphs in LoadFontData(), 0 for one per core
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+static unsigned int GlyphTableHash(int codepoint);                          // Hash of a codepoint out of the BMP
+static rGlyphTable *LoadGlyphTable(const GlyphInfo *glyphs, int glyphCount);  // Build codepoint to glyph index table
+static void UnloadGlyphTable(rGlyphTable *table);                            // Unload codepoint to glyph index table
+#endif
+#if defined(SUPPORT_FILEFORMAT_TTF) || defined(SUPPORT_FILEFORMAT_BDF)
+static void LoadFontAtlas(Font *font, int packMethod);  // Generate and load atlas texture of loaded font glyphs
+#endif
+static void DrawTextGlyph(Font font, int index, Vector2 position, float fontSize, Color tint); // Draw glyph by index
+static void SetGlyphNormalSDF(int baseSize, float fontSize);    // Set normal marking next vertices as SDF glyph quads
+#if defined(SUPPORT_FILEFORMAT_TTF)
+static void LoadFontGlyphs(FontLoadJob *job);       // Rasterize the glyphs of a job, shared by the LoadFontData() threads
+static void LoadFontGlyph(const stbtt_fontinfo *fontInfo, FontLoadJob *job, int i); // Rasterize one glyph of a job
+#if defined(SUPPORT_FONT_LOAD_THREADS)
+static void *LoadFontGlyphsThread(void *job);       // Thread entry point for LoadFontGlyphs()
+#endif
+#endif
+static Vector2 MeasureTextRun(Font font, const char *text, float fontSize, float spacing);  // Measure text size, without cache
+static bool IsTextLayoutCurrent(const TextLayout *layout, Font font, const char *text, float fontSize, float spacing); // Check layout was shaped from these parameters
+static void ShapeTextLayout(TextLayout *layout, Font font, const char *text, float fontSize, float spacing); // Shape text into layout glyph quads
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+static const TextLayout *GetCachedTextLayout(Font font, const char *text, float fontSize, float spacing); // Get layout from cache, shaped on a miss
+static void InvalidateTextLayoutCache(Font font);   // Drop cached layouts of a font
+#endif
 
 #if defined(SUPPORT_DEFAULT_FONT)
 extern void LoadFontDefault(void);
@@ -301,6 +451,9 @@ extern void LoadFontDefault(void)
     UnloadImage(imFont);
 
     defaultFont.baseSize = (int)defaultFont.recs[0].height;
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    defaultFont.glyphTable = LoadGlyphTable(defaultFont.glyphs, defaultFont.glyphCount);
+#endif
 
     TRACELOG(LOG_INFO, "FONT: Default font loaded successfully (%i glyphs)", defaultFont.glyphCount);
 }
@@ -312,6 +465,16 @@ extern void UnloadFontDefault(void)
     if (isGpuReady) UnloadTexture(defaultFont.texture);
     RL_FREE(defaultFont.glyphs);
     RL_FREE(defaultFont.recs);
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    UnloadGlyphTable(defaultFont.glyphTable);
+    defaultFont.glyphTable = NULL;
+#endif
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+    // Text layouts cache is released with the default font, on window close
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++) UnloadTextLayout(textLayoutCache[i]);
+    memset(textLayoutCache, 0, sizeof(textLayoutCache));
+    textLayoutCacheNext = 0;
+#endif
 }
 #endif      // SUPPORT_DEFAULT_FONT
 
@@ -353,6 +516,10 @@ Font LoadFont(const char *fileName)
     if (IsFileExtension(fileName, ".fnt")) font = LoadBMFont(fileName);
     else
 #endif
+#if defined(SUPPORT_FILEFORMAT_RFNT)
+    if (IsFileExtension(fileName, ".rfnt")) font = LoadFontEx(fileName, 0, NULL, 0);
+    else
+#endif
 #if defined(SUPPORT_FILEFORMAT_BDF)
     if (IsFileExtension(fileName, ".bdf")) font = LoadFontEx(fileName, FONT_TTF_DEFAULT_SIZE, NULL, FONT_TTF_DEFAULT_NUMCHARS);
     else
@@ -368,7 +535,8 @@ Font LoadFont(const char *fileName)
         if (font.texture.id == 0) TRACELOG(LOG_WARNING, "FONT: [%s] Failed to load font texture -> Using default font", fileName);
         else
         {
-            SetTextureFilter(font.texture, TEXTURE_FILTER_POINT);    // By default, we set point filter (the best performance)
+            // By default, we set point filter (the best performance), SDF distance values need interpolation
+            SetTextureFilter(font.texture, (font.type == FONT_SDF)? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
             TRACELOG(LOG_INFO, "FONT: Data loaded successfully (%i pixel size | %i glyphs)", FONT_TTF_DEFAULT_SIZE, FONT_TTF_DEFAULT_NUMCHARS);
         }
     }
@@ -519,6 +687,9 @@ Font LoadFontFromImage(Image image, Color key, int firstChar)
     UnloadImage(fontClear);     // Unload processed image once converted to texture
 
     font.baseSize = (int)font.recs[0].height;
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    font.glyphTable = LoadGlyphTable(font.glyphs, font.glyphCount);   // Replaces the default font one
+#endif
 
     return font;
 }
@@ -531,6 +702,17 @@ Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int
     char fileExtLower[16] = { 0 };
     strncpy(fileExtLower, TextToLower(fileType), 16 - 1);
 
+#if defined(SUPPORT_FILEFORMAT_RFNT)
+    // Baked fonts carry their own size and glyphs, fontSize and codepoints are ignored
+    if (TextIsEqual(fileExtLower, ".rfnt"))
+    {
+        font = LoadFontBaked(fileData, dataSize);
+        if (font.glyphs == NULL) font = GetFontDefault();
+
+        return font;
+    }
+#endif
+
     font.baseSize = fontSize;
     font.glyphCount = (codepointCount > 0)? codepointCount : 95;
     font.glyphPadding = 0;
@@ -559,19 +741,48 @@ Font LoadFontFromMemory(const char *fileType, const unsigned char *fileData, int
     {
         font.glyphPadding = FONT_TTF_DEFAULT_CHARS_PADDING;
 
-        Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, 0);
-        if (isGpuReady) font.texture = LoadTextureFromImage(atlas);
+        LoadFontAtlas(&font, 0);
 
-        // Update glyphs[i].image to use alpha, required to be used on ImageDrawText()
-        for (int i = 0; i < font.glyphCount; i++)
-        {
-            UnloadImage(font.glyphs[i].image);
-            font.glyphs[i].image = ImageFromImage(atlas, font.recs[i]);
-        }
+        TRACELOG(LOG_INFO, "FONT: Data loaded successfully (%i pixel size | %i glyphs)", font.baseSize, font.glyphCount);
+    }
+    else font = GetFontDefault();
+#else
+    font = GetFontDefault();
+#endif
 
-        UnloadImage(atlas);
+    return font;
+}
 
-        TRACELOG(LOG_INFO, "FONT: Data loaded successfully (%i pixel size | %i glyphs)", font.baseSize, font.glyphCount);
+// Load TTF font as signed distance field atlas
+// NOTE: Glyphs are drawn at any size from the fontSize atlas, through the shader returned by
+// LoadShapesShaderSDF(), a small fontSize is enough for large text (32..64 pixels)
+Font LoadFontSDF(const char *fileName, int fontSize, int *codepoints, int codepointCount)
+{
+    Font font = { 0 };
+
+#if defined(SUPPORT_FILEFORMAT_TTF)
+    int dataSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &dataSize);
+
+    if (fileData != NULL)
+    {
+        font.baseSize = fontSize;
+        font.glyphCount = (codepointCount > 0)? codepointCount : 95;
+        font.glyphPadding = 0;      // SDF glyph images already include FONT_SDF_CHAR_PADDING
+        font.type = FONT_SDF;
+        font.glyphs = LoadFontData(fileData, dataSize, font.baseSize, codepoints, font.glyphCount, FONT_SDF);
+
+        UnloadFileData(fileData);
+    }
+
+    if (font.glyphs != NULL)
+    {
+        LoadFontAtlas(&font, 1);
+
+        // Distance values are interpolated, the shader finds the glyph edges in between texels
+        if (isGpuReady) SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+
+        TRACELOG(LOG_INFO, "FONT: [%s] SDF font loaded successfully (%i pixel size | %i glyphs)", fileName, font.baseSize, font.glyphCount);
     }
     else font = GetFontDefault();
 #else
@@ -597,21 +808,6 @@ bool IsFontValid(Font font)
 // NOTE: Requires TTF font memory data and can generate SDF data
 GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSize, int *codepoints, int codepointCount, int type)
 {
-    // NOTE: Using some SDF generation default values,
-    // trades off precision with ability to handle *smaller* sizes
-#ifndef FONT_SDF_CHAR_PADDING
-    #define FONT_SDF_CHAR_PADDING            4      // SDF font generation char padding
-#endif
-#ifndef FONT_SDF_ON_EDGE_VALUE
-    #define FONT_SDF_ON_EDGE_VALUE         128      // SDF font generation on edge value
-#endif
-#ifndef FONT_SDF_PIXEL_DIST_SCALE
-    #define FONT_SDF_PIXEL_DIST_SCALE     64.0f     // SDF font generation pixel distance scale
-#endif
-#ifndef FONT_BITMAP_ALPHA_THRESHOLD
-    #define FONT_BITMAP_ALPHA_THRESHOLD     80      // Bitmap (B&W) font generation alpha threshold
-#endif
-
     GlyphInfo *chars = NULL;
 
 #if defined(SUPPORT_FILEFORMAT_TTF)
@@ -646,82 +842,29 @@ GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSiz
 
             chars = (GlyphInfo *)RL_CALLOC(codepointCount, sizeof(GlyphInfo));
 
-            // NOTE: Using simple packaging, one char after another
-            for (int i = 0; i < codepointCount; i++)
-            {
-                int chw = 0, chh = 0;   // Character width and height (on generation)
-                int ch = codepoints[i];  // Character value to get info for
-                chars[i].value = ch;
-
-                //  Render a unicode codepoint to a bitmap
-                //      stbtt_GetCodepointBitmap()           -- allocates and returns a bitmap
-                //      stbtt_GetCodepointBitmapBox()        -- how big the bitmap must be
-                //      stbtt_MakeCodepointBitmap()          -- renders into bitmap you provide
-
-                // Check if a glyph is available in the font
-                // WARNING: if (index == 0), glyph not found, it could fallback to default .notdef glyph (if defined in font)
-                int index = stbtt_FindGlyphIndex(&fontInfo, ch);
-
-                if (index > 0)
-                {
-                    switch (type)
-                    {
-                        case FONT_DEFAULT:
-                        case FONT_BITMAP: chars[i].image.data = stbtt_GetCodepointBitmap(&fontInfo, scaleFactor, scaleFactor, ch, &chw, &chh, &chars[i].offsetX, &chars[i].offsetY); break;
-                        case FONT_SDF: if (ch != 32) chars[i].image.data = stbtt_GetCodepointSDF(&fontInfo, scaleFactor, ch, FONT_SDF_CHAR_PADDING, FONT_SDF_ON_EDGE_VALUE, FONT_SDF_PIXEL_DIST_SCALE, &chw, &chh, &chars[i].offsetX, &chars[i].offsetY); break;
-                        default: break;
-                    }
-
-                    if (chars[i].image.data != NULL)    // Glyph data has been found in the font
-                    {
-                        stbtt_GetCodepointHMetrics(&fontInfo, ch, &chars[i].advanceX, NULL);
-                        chars[i].advanceX = (int)((float)chars[i].advanceX*scaleFactor);
+            FontLoadJob job = { fileData, codepoints, chars, codepointCount, fontSize, type, scaleFactor, ascent, 0 };
 
-                        if (chh > fontSize) TRACELOG(LOG_WARNING, "FONT: Character [0x%08x] size is bigger than expected font size", ch);
+#if defined(SUPPORT_FONT_LOAD_THREADS)
+            // Glyphs are rasterized by the calling thread and up to one more thread per core,
+            // every glyph goes to its own slot so the result does not depend on scheduling
+            int threadCount = (fontLoadThreads > 0)? fontLoadThreads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+            if (threadCount > FONT_LOAD_MAX_THREADS) threadCount = FONT_LOAD_MAX_THREADS;
+            if (threadCount > codepointCount/FONT_LOAD_MIN_GLYPHS_PER_THREAD) threadCount = codepointCount/FONT_LOAD_MIN_GLYPHS_PER_THREAD;
 
-                        // Load characters images
-                        chars[i].image.width = chw;
-                        chars[i].image.height = chh;
-                        chars[i].image.mipmaps = 1;
-                        chars[i].image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+            pthread_t threads[FONT_LOAD_MAX_THREADS];
+            int startedCount = 0;
 
-                        chars[i].offsetY += (int)((float)ascent*scaleFactor);
-                    }
+            for (int t = 1; t < threadCount; t++)
+            {
+                if (pthread_create(&threads[startedCount], NULL, LoadFontGlyphsThread, &job) == 0) startedCount++;
+            }
 
-                    // NOTE: We create an empty image for space character,
-                    // it could be further required for atlas packing
-                    if (ch == 32)
-                    {
-                        stbtt_GetCodepointHMetrics(&fontInfo, ch, &chars[i].advanceX, NULL);
-                        chars[i].advanceX = (int)((float)chars[i].advanceX*scaleFactor);
-
-                        Image imSpace = {
-                            .data = RL_CALLOC(chars[i].advanceX*fontSize, 2),
-                            .width = chars[i].advanceX,
-                            .height = fontSize,
-                            .mipmaps = 1,
-                            .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
-                        };
-
-                        chars[i].image = imSpace;
-                    }
+            LoadFontGlyphs(&job);
 
-                    if (type == FONT_BITMAP)
-                    {
-                        // Aliased bitmap (black & white) font generation, avoiding anti-aliasing
-                        // NOTE: For optimum results, bitmap font should be generated at base pixel size
-                        for (int p = 0; p < chw*chh; p++)
-                        {
-                            if (((unsigned char *)chars[i].image.data)[p] < FONT_BITMAP_ALPHA_THRESHOLD) ((unsigned char *)chars[i].image.data)[p] = 0;
-                            else ((unsigned char *)chars[i].image.data)[p] = 255;
-                        }
-                    }
-                }
-                else
-                {
-                    // TODO: Use some fallback glyph for codepoints not found in the font
-                }
-            }
+            for (int t = 0; t < startedCount; t++) pthread_join(threads[t], NULL);
+#else
+            LoadFontGlyphs(&job);
+#endif
         }
         else TRACELOG(LOG_WARNING, "FONT: Failed to process TTF font data");
 
@@ -732,6 +875,12 @@ GlyphInfo *LoadFontData(const unsigned char *fileData, int dataSize, int fontSiz
     return chars;
 }
 
+// Set the number of threads rasterizing glyphs in LoadFontData(), 0 for one per core
+void SetFontLoadThreads(int threads)
+{
+    fontLoadThreads = threads;
+}
+
 // Generate image font atlas using chars info
 // NOTE: Packing method: 0-Default, 1-Skyline
 #if defined(SUPPORT_FILEFORMAT_TTF) || defined(SUPPORT_FILEFORMAT_BDF)
@@ -953,6 +1102,12 @@ void UnloadFont(Font font)
         UnloadFontData(font.glyphs, font.glyphCount);
         if (isGpuReady) UnloadTexture(font.texture);
         RL_FREE(font.recs);
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+        UnloadGlyphTable(font.glyphTable);
+#endif
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+        InvalidateTextLayoutCache(font);    // Font data pointers could be reused by a new font
+#endif
 
         TRACELOGD("FONT: Unloaded font data from RAM and VRAM");
     }
@@ -1112,6 +1267,80 @@ bool ExportFontAsCode(Font font, const char *fileName)
     return success;
 }
 
+// Export font as baked font file (.rfnt), returns true on success
+// NOTE: The atlas image is the one the font texture was loaded from [GenImageFontAtlas()],
+// a baked font is loaded back with LoadFont(), LoadFontEx() or LoadFontFromMemory()
+bool ExportFontBaked(Font font, Image atlas, bool compressed, const char *fileName)
+{
+    bool success = false;
+
+    if ((font.glyphs == NULL) || (font.recs == NULL) || (font.glyphCount <= 0) || (atlas.data == NULL))
+    {
+        TRACELOG(LOG_WARNING, "FILEIO: [%s] Failed to export baked font, font or atlas data not valid", fileName);
+        return false;
+    }
+
+#if !defined(SUPPORT_COMPRESSION_API)
+    if (compressed) TRACELOG(LOG_WARNING, "FILEIO: [%s] Compression not supported, baked font atlas stored uncompressed", fileName);
+    compressed = false;
+#endif
+
+    int pixelDataSize = GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    int glyphDataSize = font.glyphCount*sizeof(BakedGlyph);
+    int atlasDataSize = pixelDataSize;
+#if defined(SUPPORT_COMPRESSION_API)
+    if (compressed) atlasDataSize = sdefl_bound(pixelDataSize);
+#endif
+
+    unsigned char *fileData = (unsigned char *)RL_CALLOC(sizeof(BakedFontHeader) + glyphDataSize + atlasDataSize, 1);
+    BakedFontHeader *header = (BakedFontHeader *)fileData;
+    BakedGlyph *glyphs = (BakedGlyph *)(fileData + sizeof(BakedFontHeader));
+    unsigned char *atlasData = fileData + sizeof(BakedFontHeader) + glyphDataSize;
+
+    for (int i = 0; i < font.glyphCount; i++)
+    {
+        glyphs[i].value = font.glyphs[i].value;
+        glyphs[i].offsetX = font.glyphs[i].offsetX;
+        glyphs[i].offsetY = font.glyphs[i].offsetY;
+        glyphs[i].advanceX = font.glyphs[i].advanceX;
+        glyphs[i].rec = font.recs[i];
+    }
+
+#if defined(SUPPORT_COMPRESSION_API)
+    if (compressed)
+    {
+        struct sdefl *sdefl = RL_CALLOC(1, sizeof(struct sdefl));   // WARNING: struct sdefl is almost 1MB
+        atlasDataSize = sdeflate(sdefl, atlasData, atlas.data, pixelDataSize, SDEFL_LVL_MAX);
+        RL_FREE(sdefl);
+    }
+    else
+#endif
+    {
+        memcpy(atlasData, atlas.data, pixelDataSize);
+    }
+
+    memcpy(header->id, "rFNT", 4);
+    header->version = BAKED_FONT_VERSION;
+    header->baseSize = font.baseSize;
+    header->glyphCount = font.glyphCount;
+    header->glyphPadding = font.glyphPadding;
+    header->type = font.type;
+    header->atlasWidth = atlas.width;
+    header->atlasHeight = atlas.height;
+    header->atlasFormat = atlas.format;
+    header->atlasCompressed = compressed;
+    header->atlasDataSize = atlasDataSize;
+
+    success = SaveFileData(fileName, fileData, sizeof(BakedFontHeader) + glyphDataSize + atlasDataSize);
+
+    RL_FREE(fileData);
+
+    if (success != 0) TRACELOG(LOG_INFO, "FILEIO: [%s] Baked font exported successfully (%i glyphs | atlas %i -> %i bytes)", fileName, font.glyphCount, pixelDataSize, atlasDataSize);
+    else TRACELOG(LOG_WARNING, "FILEIO: [%s] Failed to export baked font", fileName);
+
+    return success;
+}
+
 // Draw current FPS
 // NOTE: Uses default font
 void DrawFPS(int posX, int posY)
@@ -1151,6 +1380,15 @@ void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, f
 
     int size = TextLength(text);    // Total size in bytes of the text, scanned by codepoints in loop
 
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+    // Strings drawn again are submitted from their cached glyph quads
+    if ((size > 0) && (size <= TEXT_LAYOUT_CACHE_MAX_LENGTH))
+    {
+        DrawTextLayout(*GetCachedTextLayout(font, text, fontSize, spacing), position, tint);
+        return;
+    }
+#endif
+
     float textOffsetY = 0;          // Offset between lines (on linebreak '\n')
     float textOffsetX = 0.0f;       // Offset X to next character to draw
 
@@ -1173,7 +1411,7 @@ void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, f
         {
             if ((codepoint != ' ') && (codepoint != '\t'))
             {
-                DrawTextCodepoint(font, codepoint, (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
+                DrawTextGlyph(font, index, (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
             }
 
             if (font.glyphs[index].advanceX == 0) textOffsetX += ((float)font.recs[index].width*scaleFactor + spacing);
@@ -1203,7 +1441,12 @@ void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSiz
 {
     // Character index position in sprite font
     // NOTE: In case a codepoint is not available in the font, index returned points to '?'
-    int index = GetGlyphIndex(font, codepoint);
+    DrawTextGlyph(font, GetGlyphIndex(font, codepoint), position, fontSize, tint);
+}
+
+// Draw one glyph by its index in the font, callers already looked the codepoint up
+static void DrawTextGlyph(Font font, int index, Vector2 position, float fontSize, Color tint)
+{
     float scaleFactor = fontSize/font.baseSize;     // Character quad scaling factor
 
     // Character destination rectangle on screen
@@ -1218,8 +1461,47 @@ void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSiz
     Rectangle srcRec = { font.recs[index].x - (float)font.glyphPadding, font.recs[index].y - (float)font.glyphPadding,
                          font.recs[index].width + 2.0f*font.glyphPadding, font.recs[index].height + 2.0f*font.glyphPadding };
 
-    // Draw the character texture on the screen
-    DrawTexturePro(font.texture, srcRec, dstRec, (Vector2){ 0, 0 }, 0.0f, tint);
+    if (font.type == FONT_SDF)
+    {
+        // Same quad as DrawTexturePro(), which would reset the normal marking it as SDF glyph
+        float width = (float)font.texture.width;
+        float height = (float)font.texture.height;
+
+        rlSetTexture(font.texture.id);
+        rlBegin(RL_QUADS);
+
+            rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+            SetGlyphNormalSDF(font.baseSize, fontSize);
+
+            rlTexCoord2f(srcRec.x/width, srcRec.y/height);
+            rlVertex2f(dstRec.x, dstRec.y);
+
+            rlTexCoord2f(srcRec.x/width, (srcRec.y + srcRec.height)/height);
+            rlVertex2f(dstRec.x, dstRec.y + dstRec.height);
+
+            rlTexCoord2f((srcRec.x + srcRec.width)/width, (srcRec.y + srcRec.height)/height);
+            rlVertex2f(dstRec.x + dstRec.width, dstRec.y + dstRec.height);
+
+            rlTexCoord2f((srcRec.x + srcRec.width)/width, srcRec.y/height);
+            rlVertex2f(dstRec.x + dstRec.width, dstRec.y);
+
+            rlNormal3f(0.0f, 0.0f, 1.0f);       // Restore regular geometry normal
+
+        rlEnd();
+        rlSetTexture(0);
+    }
+    else DrawTexturePro(font.texture, srcRec, dstRec, (Vector2){ 0, 0 }, 0.0f, tint);    // Draw the character texture on the screen
+}
+
+// Set the normal of the next vertices, marking them as SDF glyph quads for the SDF shapes shader
+// NOTE: rlNormal3f() normalizes the vector, so the distance value change over one pixel at fontSize
+// is passed as the xy length to z ratio, which also survives rotations around the z axis.
+// A positive z with non-zero xy tells glyphs apart, the shader expects FONT_SDF_ON_EDGE_VALUE at 128
+static void SetGlyphNormalSDF(int baseSize, float fontSize)
+{
+    float pixelDistance = (FONT_SDF_PIXEL_DIST_SCALE/255.0f)*(float)baseSize/fontSize;
+
+    rlNormal3f(pixelDistance, 0.0f, 1.0f);
 }
 
 // Draw multiple character (codepoints)
@@ -1244,7 +1526,7 @@ void DrawTextCodepoints(Font font, const int *codepoints, int codepointCount, Ve
         {
             if ((codepoints[i] != ' ') && (codepoints[i] != '\t'))
             {
-                DrawTextCodepoint(font, codepoints[i], (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
+                DrawTextGlyph(font, index, (Vector2){ position.x + textOffsetX, position.y + textOffsetY }, fontSize, tint);
             }
 
             if (font.glyphs[index].advanceX == 0) textOffsetX += ((float)font.recs[index].width*scaleFactor + spacing);
@@ -1253,6 +1535,74 @@ void DrawTextCodepoints(Font font, const int *codepoints, int codepointCount, Ve
     }
 }
 
+// Load text layout, text shaped into glyph quads
+TextLayout LoadTextLayout(Font font, const char *text, float fontSize, float spacing)
+{
+    TextLayout layout = { 0 };
+
+    UpdateTextLayout(&layout, font, text, fontSize, spacing);
+
+    return layout;
+}
+
+// Update text layout, shaped again only if text, font or size changed
+// NOTE: Buffers are reused, they only grow when the text gets longer than any text shaped before
+bool UpdateTextLayout(TextLayout *layout, Font font, const char *text, float fontSize, float spacing)
+{
+    if (font.texture.id == 0) font = GetFontDefault();  // Security check in case of not valid font, like DrawTextEx()
+    if (text == NULL) text = "";
+
+    if (IsTextLayoutCurrent(layout, font, text, fontSize, spacing)) return false;
+
+    ShapeTextLayout(layout, font, text, fontSize, spacing);
+
+    return true;
+}
+
+// Unload text layout
+void UnloadTextLayout(TextLayout layout)
+{
+    RL_FREE(layout.text);
+    RL_FREE(layout.quads);
+}
+
+// Draw text layout, all glyph quads submitted in a single batch
+// NOTE: Same vertices as DrawTextEx() drawing every glyph with DrawTexturePro()
+void DrawTextLayout(TextLayout layout, Vector2 position, Color tint)
+{
+    if ((layout.glyphCount == 0) || (layout.font.texture.id == 0)) return;
+
+    rlSetTexture(layout.font.texture.id);
+    rlBegin(RL_QUADS);
+
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        if (layout.font.type == FONT_SDF) SetGlyphNormalSDF(layout.font.baseSize, layout.fontSize);
+        else rlNormal3f(0.0f, 0.0f, 1.0f);                     // Normal vector pointing towards viewer
+
+        for (int i = 0; i < layout.glyphCount; i++)
+        {
+            const float *quad = &layout.quads[i*8];
+
+            // Top-left, bottom-left, bottom-right and top-right corners
+            rlTexCoord2f(quad[4], quad[5]);
+            rlVertex2f(position.x + quad[0], position.y + quad[1]);
+
+            rlTexCoord2f(quad[4], quad[7]);
+            rlVertex2f(position.x + quad[0], position.y + quad[3]);
+
+            rlTexCoord2f(quad[6], quad[7]);
+            rlVertex2f(position.x + quad[2], position.y + quad[3]);
+
+            rlTexCoord2f(quad[6], quad[5]);
+            rlVertex2f(position.x + quad[2], position.y + quad[1]);
+        }
+
+        rlNormal3f(0.0f, 0.0f, 1.0f);                          // Restore regular geometry normal
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
 // Set vertical line spacing when drawing with line-breaks
 void SetTextLineSpacing(int spacing)
 {
@@ -1285,6 +1635,22 @@ Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing
     if ((isGpuReady && (font.texture.id == 0)) || 
         (text == NULL) || (text[0] == '\0')) return textSize; // Security check
 
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+    // Size of a string already drawn or measured is taken from its cached layout
+    if (TextLength(text) <= TEXT_LAYOUT_CACHE_MAX_LENGTH) textSize = GetCachedTextLayout(font, text, fontSize, spacing)->size;
+    else
+#endif
+    textSize = MeasureTextRun(font, text, fontSize, spacing);
+
+    return textSize;
+}
+
+// Measure text size, without cache
+// NOTE: Text is not empty, checked by callers
+static Vector2 MeasureTextRun(Font font, const char *text, float fontSize, float spacing)
+{
+    Vector2 textSize = { 0 };
+
     int size = TextLength(text);    // Get size in bytes of text
     int tempByteCounter = 0;        // Used to count longer text line num chars
     int byteCounter = 0;
@@ -1340,6 +1706,31 @@ int GetGlyphIndex(Font font, int codepoint)
 {
     int index = 0;
 
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    const rGlyphTable *table = font.glyphTable;
+
+    if (table != NULL)
+    {
+        if ((codepoint >= 0) && (codepoint < 0x10000))
+        {
+            int page = table->pages[codepoint/GLYPH_TABLE_PAGE_SIZE];
+            index = (page > 0)? table->entries[(page - 1)*GLYPH_TABLE_PAGE_SIZE + codepoint%GLYPH_TABLE_PAGE_SIZE] : -1;
+        }
+        else
+        {
+            index = -1;
+            for (unsigned int slot = GlyphTableHash(codepoint); table->hashSize > 0; slot++)
+            {
+                slot &= (table->hashSize - 1);
+                if (table->hashValues[slot] < 0) break;
+                if (table->hashKeys[slot] == codepoint) { index = table->hashValues[slot]; break; }
+            }
+        }
+
+        return (index >= 0)? index : table->fallback;
+    }
+#endif
+
 #define SUPPORT_UNORDERED_CHARSET
 #if defined(SUPPORT_UNORDERED_CHARSET)
     int fallbackIndex = 0;      // Get index of fallback glyph '?'
@@ -2135,6 +2526,28 @@ int GetCodepointPrevious(const char *text, int *codepointSize)
 //----------------------------------------------------------------------------------
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
+#if defined(SUPPORT_FILEFORMAT_TTF) || defined(SUPPORT_FILEFORMAT_BDF)
+// Generate atlas of the loaded font glyphs and load it as font texture
+// NOTE: Glyph images are replaced by their atlas copy (with alpha), required to be used on ImageDrawText()
+static void LoadFontAtlas(Font *font, int packMethod)
+{
+    Image atlas = GenImageFontAtlas(font->glyphs, &font->recs, font->glyphCount, font->baseSize, font->glyphPadding, packMethod);
+    if (isGpuReady) font->texture = LoadTextureFromImage(atlas);
+
+    for (int i = 0; i < font->glyphCount; i++)
+    {
+        UnloadImage(font->glyphs[i].image);
+        font->glyphs[i].image = ImageFromImage(atlas, font->recs[i]);
+    }
+
+    UnloadImage(atlas);
+
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    font->glyphTable = LoadGlyphTable(font->glyphs, font->glyphCount);
+#endif
+}
+#endif
+
 #if defined(SUPPORT_FILEFORMAT_FNT) || defined(SUPPORT_FILEFORMAT_BDF)
 // Read a line from memory
 // REQUIRES: memcpy()
@@ -2306,6 +2719,10 @@ static Font LoadBMFont(const char *fileName)
     UnloadImage(fullFont);
     UnloadFileText(fileText);
 
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    font.glyphTable = LoadGlyphTable(font.glyphs, font.glyphCount);
+#endif
+
     if (isGpuReady && (font.texture.id == 0))
     {
         UnloadFont(font);
@@ -2319,6 +2736,99 @@ static Font LoadBMFont(const char *fileName)
 
 #endif
 
+#if defined(SUPPORT_FILEFORMAT_RFNT)
+// Load a baked font file (.rfnt) from memory, written by ExportFontBaked()
+// NOTE: Glyph metrics and recs are copied, the atlas pixels are uploaded from the file data itself
+// (or inflated once), glyph images are not kept: ImageText*() draws nothing with a baked font
+static Font LoadFontBaked(const unsigned char *fileData, int dataSize)
+{
+    Font font = { 0 };
+    BakedFontHeader header = { 0 };
+
+    if ((fileData != NULL) && (dataSize >= (int)sizeof(BakedFontHeader))) memcpy(&header, fileData, sizeof(BakedFontHeader));
+
+    if ((memcmp(header.id, "rFNT", 4) != 0) || (header.version != BAKED_FONT_VERSION))
+    {
+        TRACELOG(LOG_WARNING, "FONT: Baked font data not valid or version not supported");
+        return font;
+    }
+
+    int pixelDataSize = GetPixelDataSize(header.atlasWidth, header.atlasHeight, header.atlasFormat);
+    long long expectedSize = (long long)sizeof(BakedFontHeader) + (long long)header.glyphCount*sizeof(BakedGlyph) + header.atlasDataSize;
+
+    if ((header.baseSize <= 0) || (header.glyphCount <= 0) || (pixelDataSize <= 0) || (header.atlasDataSize <= 0) ||
+        (expectedSize != dataSize) || (!header.atlasCompressed && (header.atlasDataSize != pixelDataSize)))
+    {
+        TRACELOG(LOG_WARNING, "FONT: Baked font data size not valid");
+        return font;
+    }
+
+    const unsigned char *glyphData = fileData + sizeof(BakedFontHeader);
+    const unsigned char *atlasData = glyphData + header.glyphCount*sizeof(BakedGlyph);
+    unsigned char *pixels = (unsigned char *)atlasData;
+
+    if (header.atlasCompressed)
+    {
+#if defined(SUPPORT_COMPRESSION_API)
+        pixels = (unsigned char *)RL_MALLOC(pixelDataSize);
+        if (sinflate(pixels, pixelDataSize, atlasData, header.atlasDataSize) != pixelDataSize)
+        {
+            RL_FREE(pixels);
+            pixels = NULL;
+        }
+#else
+        pixels = NULL;
+#endif
+        if (pixels == NULL)
+        {
+            TRACELOG(LOG_WARNING, "FONT: Baked font atlas could not be decompressed");
+            return font;
+        }
+    }
+
+    font.baseSize = header.baseSize;
+    font.glyphCount = header.glyphCount;
+    font.glyphPadding = header.glyphPadding;
+    font.type = header.type;
+    font.glyphs = (GlyphInfo *)RL_CALLOC(font.glyphCount, sizeof(GlyphInfo));
+    font.recs = (Rectangle *)RL_MALLOC(font.glyphCount*sizeof(Rectangle));
+
+    for (int i = 0; i < font.glyphCount; i++)
+    {
+        BakedGlyph glyph = { 0 };
+        memcpy(&glyph, glyphData + i*sizeof(BakedGlyph), sizeof(BakedGlyph));
+
+        font.glyphs[i].value = glyph.value;
+        font.glyphs[i].offsetX = glyph.offsetX;
+        font.glyphs[i].offsetY = glyph.offsetY;
+        font.glyphs[i].advanceX = glyph.advanceX;
+        font.recs[i] = glyph.rec;
+    }
+
+    if (isGpuReady)
+    {
+        font.texture.id = rlLoadTexture(pixels, header.atlasWidth, header.atlasHeight, header.atlasFormat, 1);
+        font.texture.width = header.atlasWidth;
+        font.texture.height = header.atlasHeight;
+        font.texture.mipmaps = 1;
+        font.texture.format = header.atlasFormat;
+
+        // Distance values are interpolated, like on LoadFontSDF()
+        if (font.type == FONT_SDF) SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    }
+
+    if (pixels != atlasData) RL_FREE(pixels);
+
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+    font.glyphTable = LoadGlyphTable(font.glyphs, font.glyphCount);
+#endif
+
+    TRACELOG(LOG_INFO, "FONT: Baked font loaded successfully (%i pixel size | %i glyphs)", font.baseSize, font.glyphCount);
+
+    return font;
+}
+#endif
+
 #if defined(SUPPORT_FILEFORMAT_BDF)
 
 // Convert hexadecimal to decimal (single digit)
@@ -2570,4 +3080,327 @@ static GlyphInfo *LoadFontDataBDF(const unsigned char *fileData, int dataSize, i
 }
 #endif      // SUPPORT_FILEFORMAT_BDF
 
+#if defined(SUPPORT_FILEFORMAT_TTF)
+// Rasterize the glyphs of a job, shared by the LoadFontData() threads
+// NOTE: Every thread initializes its own font info view of the read-only TTF data
+static void LoadFontGlyphs(FontLoadJob *job)
+{
+    stbtt_fontinfo fontInfo = { 0 };
+    if (!stbtt_InitFont(&fontInfo, (unsigned char *)job->fileData, 0)) return;
+
+    for (;;)
+    {
+        int i = __atomic_fetch_add(&job->nextGlyph, 1, __ATOMIC_RELAXED);
+        if (i >= job->glyphCount) break;
+
+        LoadFontGlyph(&fontInfo, job, i);
+    }
+}
+
+#if defined(SUPPORT_FONT_LOAD_THREADS)
+// Thread entry point for LoadFontGlyphs()
+static void *LoadFontGlyphsThread(void *job)
+{
+    LoadFontGlyphs((FontLoadJob *)job);
+
+    return NULL;
+}
+#endif
+
+// Rasterize one glyph of a job into its slot
+static void LoadFontGlyph(const stbtt_fontinfo *fontInfo, FontLoadJob *job, int i)
+{
+#ifndef FONT_BITMAP_ALPHA_THRESHOLD
+    #define FONT_BITMAP_ALPHA_THRESHOLD     80      // Bitmap (B&W) font generation alpha threshold
+#endif
+
+    GlyphInfo *chars = job->glyphs;
+    float scaleFactor = job->scaleFactor;
+    int fontSize = job->fontSize;
+    int type = job->type;
+
+    int chw = 0, chh = 0;   // Character width and height (on generation)
+    int ch = job->codepoints[i];  // Character value to get info for
+    chars[i].value = ch;
+
+    //  Render a unicode codepoint to a bitmap
+    //      stbtt_GetCodepointBitmap()           -- allocates and returns a bitmap
+    //      stbtt_GetCodepointBitmapBox()        -- how big the bitmap must be
+    //      stbtt_MakeCodepointBitmap()          -- renders into bitmap you provide
+
+    // Check if a glyph is available in the font
+    // WARNING: if (index == 0), glyph not found, it could fallback to default .notdef glyph (if defined in font)
+    int index = stbtt_FindGlyphIndex(fontInfo, ch);
+
+    if (index > 0)
+    {
+        switch (type)
+        {
+            case FONT_DEFAULT:
+            case FONT_BITMAP: chars[i].image.data = stbtt_GetCodepointBitmap(fontInfo, scaleFactor, scaleFactor, ch, &chw, &chh, &chars[i].offsetX, &chars[i].offsetY); break;
+            case FONT_SDF: if (ch != 32) chars[i].image.data = stbtt_GetCodepointSDF(fontInfo, scaleFactor, ch, FONT_SDF_CHAR_PADDING, FONT_SDF_ON_EDGE_VALUE, FONT_SDF_PIXEL_DIST_SCALE, &chw, &chh, &chars[i].offsetX, &chars[i].offsetY); break;
+            default: break;
+        }
+
+        if (chars[i].image.data != NULL)    // Glyph data has been found in the font
+        {
+            stbtt_GetCodepointHMetrics(fontInfo, ch, &chars[i].advanceX, NULL);
+            chars[i].advanceX = (int)((float)chars[i].advanceX*scaleFactor);
+
+            // NOTE: SDF glyph images include the distance field padding on both sides
+            if (chh > fontSize + ((type == FONT_SDF)? 2*FONT_SDF_CHAR_PADDING : 0)) TRACELOG(LOG_WARNING, "FONT: Character [0x%08x] size is bigger than expected font size", ch);
+
+            // Load characters images
+            chars[i].image.width = chw;
+            chars[i].image.height = chh;
+            chars[i].image.mipmaps = 1;
+            chars[i].image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+
+            chars[i].offsetY += (int)((float)job->ascent*scaleFactor);
+        }
+
+        // NOTE: We create an empty image for space character,
+        // it could be further required for atlas packing
+        if (ch == 32)
+        {
+            stbtt_GetCodepointHMetrics(fontInfo, ch, &chars[i].advanceX, NULL);
+            chars[i].advanceX = (int)((float)chars[i].advanceX*scaleFactor);
+
+            Image imSpace = {
+                .data = RL_CALLOC(chars[i].advanceX*fontSize, 2),
+                .width = chars[i].advanceX,
+                .height = fontSize,
+                .mipmaps = 1,
+                .format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
+            };
+
+            chars[i].image = imSpace;
+        }
+
+        if (type == FONT_BITMAP)
+        {
+            // Aliased bitmap (black & white) font generation, avoiding anti-aliasing
+            // NOTE: For optimum results, bitmap font should be generated at base pixel size
+            for (int p = 0; p < chw*chh; p++)
+            {
+                if (((unsigned char *)chars[i].image.data)[p] < FONT_BITMAP_ALPHA_THRESHOLD) ((unsigned char *)chars[i].image.data)[p] = 0;
+                else ((unsigned char *)chars[i].image.data)[p] = 255;
+            }
+        }
+    }
+    else
+    {
+        // TODO: Use some fallback glyph for codepoints not found in the font
+    }
+}
+#endif      // SUPPORT_FILEFORMAT_TTF
+
+// Check layout was shaped from these parameters
+static bool IsTextLayoutCurrent(const TextLayout *layout, Font font, const char *text, float fontSize, float spacing)
+{
+    return ((layout->text != NULL) &&
+            (layout->font.texture.id == font.texture.id) && (layout->font.glyphs == font.glyphs) &&
+            (layout->font.recs == font.recs) && (layout->font.baseSize == font.baseSize) &&
+            (layout->fontSize == fontSize) && (layout->spacing == spacing) &&
+            (layout->lineSpacing == textLineSpacing) && (strcmp(layout->text, text) == 0));
+}
+
+// Shape text into layout glyph quads
+// NOTE: Glyph placement follows DrawTextEx(), size follows MeasureTextEx()
+static void ShapeTextLayout(TextLayout *layout, Font font, const char *text, float fontSize, float spacing)
+{
+    int size = TextLength(text);    // Total size in bytes of the text, at most one glyph per byte
+
+    if (layout->textCapacity < size + 1)
+    {
+        int capacity = (size + 1 > TEXT_LAYOUT_MIN_CAPACITY)? size + 1 : TEXT_LAYOUT_MIN_CAPACITY;
+        RL_FREE(layout->text);
+        layout->text = (char *)RL_MALLOC(capacity);
+        layout->textCapacity = capacity;
+    }
+
+    if (layout->glyphCapacity < size)
+    {
+        int capacity = (size > TEXT_LAYOUT_MIN_CAPACITY)? size : TEXT_LAYOUT_MIN_CAPACITY;
+        RL_FREE(layout->quads);
+        layout->quads = (float *)RL_MALLOC(capacity*8*sizeof(float));
+        layout->glyphCapacity = capacity;
+    }
+
+    memcpy(layout->text, text, size + 1);
+    layout->font = font;
+    layout->fontSize = fontSize;
+    layout->spacing = spacing;
+    layout->lineSpacing = textLineSpacing;
+    layout->glyphCount = 0;
+
+    float textOffsetY = 0;          // Offset between lines (on linebreak '\n')
+    float textOffsetX = 0.0f;       // Offset X to next character to draw
+
+    float scaleFactor = fontSize/font.baseSize;         // Character quad scaling factor
+    float padding = (float)font.glyphPadding;
+    float width = (float)font.texture.width;
+    float height = (float)font.texture.height;
+
+    for (int i = 0; i < size;)
+    {
+        // Get next codepoint from byte string and glyph index in font
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        int index = GetGlyphIndex(font, codepoint);
+
+        if (codepoint == '\n')
+        {
+            // NOTE: Line spacing is a global variable, use SetTextLineSpacing() to setup
+            textOffsetY += (fontSize + textLineSpacing);
+            textOffsetX = 0.0f;
+        }
+        else
+        {
+            if ((codepoint != ' ') && (codepoint != '\t') && (width > 0.0f) && (height > 0.0f))
+            {
+                // Same destination and source rectangles as DrawTextGlyph()
+                Rectangle rec = font.recs[index];
+                float *quad = &layout->quads[layout->glyphCount*8];
+
+                quad[0] = textOffsetX + font.glyphs[index].offsetX*scaleFactor - padding*scaleFactor;
+                quad[1] = textOffsetY + font.glyphs[index].offsetY*scaleFactor - padding*scaleFactor;
+                quad[2] = quad[0] + (rec.width + 2.0f*padding)*scaleFactor;
+                quad[3] = quad[1] + (rec.height + 2.0f*padding)*scaleFactor;
+                quad[4] = (rec.x - padding)/width;
+                quad[5] = (rec.y - padding)/height;
+                quad[6] = (rec.x + rec.width + padding)/width;
+                quad[7] = (rec.y + rec.height + padding)/height;
+
+                layout->glyphCount++;
+            }
+
+            if (font.glyphs[index].advanceX == 0) textOffsetX += ((float)font.recs[index].width*scaleFactor + spacing);
+            else textOffsetX += ((float)font.glyphs[index].advanceX*scaleFactor + spacing);
+        }
+
+        i += codepointByteCount;   // Move text bytes counter to next codepoint
+    }
+
+    layout->size = (size > 0)? MeasureTextRun(font, text, fontSize, spacing) : (Vector2){ 0.0f, 0.0f };
+}
+
+#if defined(SUPPORT_TEXT_LAYOUT_CACHE)
+// Get layout from cache, shaped on a miss replacing the entries in round-robin order
+static const TextLayout *GetCachedTextLayout(Font font, const char *text, float fontSize, float spacing)
+{
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++)
+    {
+        if (IsTextLayoutCurrent(&textLayoutCache[i], font, text, fontSize, spacing)) return &textLayoutCache[i];
+    }
+
+    TextLayout *layout = &textLayoutCache[textLayoutCacheNext];
+    textLayoutCacheNext = (textLayoutCacheNext + 1)%TEXT_LAYOUT_CACHE_SIZE;
+
+    ShapeTextLayout(layout, font, text, fontSize, spacing);
+
+    return layout;
+}
+
+// Drop cached layouts of a font, their buffers are kept for reuse
+static void InvalidateTextLayoutCache(Font font)
+{
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++)
+    {
+        if (textLayoutCache[i].font.glyphs == font.glyphs)
+        {
+            textLayoutCache[i].font = (Font){ 0 };
+            textLayoutCache[i].glyphCount = 0;
+            if (textLayoutCache[i].text != NULL) textLayoutCache[i].text[0] = '\0';
+        }
+    }
+}
+#endif      // SUPPORT_TEXT_LAYOUT_CACHE
+
+#if defined(SUPPORT_GLYPH_INDEX_TABLE)
+// Hash of a codepoint out of the BMP (multiplicative, the high bits are the well mixed ones)
+static unsigned int GlyphTableHash(int codepoint)
+{
+    return ((unsigned int)codepoint*2654435761u) >> 16;
+}
+
+// Build codepoint to glyph index table
+// NOTE: Same results as the linear search: first glyph of a codepoint, last '?' as fallback
+static rGlyphTable *LoadGlyphTable(const GlyphInfo *glyphs, int glyphCount)
+{
+    if ((glyphs == NULL) || (glyphCount <= 0)) return NULL;
+
+    rGlyphTable *table = (rGlyphTable *)RL_CALLOC(1, sizeof(rGlyphTable));
+
+    // Allocate the BMP pages holding glyphs, count the codepoints going to the hash table
+    int pageCount = 0;
+    int hashCount = 0;
+
+    for (int i = 0; i < glyphCount; i++)
+    {
+        int codepoint = glyphs[i].value;
+
+        if (codepoint == 63) table->fallback = i;
+
+        if ((codepoint >= 0) && (codepoint < 0x10000))
+        {
+            if (table->pages[codepoint/GLYPH_TABLE_PAGE_SIZE] == 0) table->pages[codepoint/GLYPH_TABLE_PAGE_SIZE] = (unsigned short)(++pageCount);
+        }
+        else hashCount++;
+    }
+
+    table->entries = (int *)RL_MALLOC(pageCount*GLYPH_TABLE_PAGE_SIZE*sizeof(int));
+    for (int i = 0; i < pageCount*GLYPH_TABLE_PAGE_SIZE; i++) table->entries[i] = -1;
+
+    if (hashCount > 0)
+    {
+        table->hashSize = 4;
+        while (table->hashSize < hashCount*2) table->hashSize *= 2;     // Load factor below 0.5
+
+        table->hashKeys = (int *)RL_CALLOC(table->hashSize, sizeof(int));
+        table->hashValues = (int *)RL_MALLOC(table->hashSize*sizeof(int));
+        for (int i = 0; i < table->hashSize; i++) table->hashValues[i] = -1;
+    }
+
+    for (int i = 0; i < glyphCount; i++)
+    {
+        int codepoint = glyphs[i].value;
+
+        if ((codepoint >= 0) && (codepoint < 0x10000))
+        {
+            int *entry = &table->entries[(table->pages[codepoint/GLYPH_TABLE_PAGE_SIZE] - 1)*GLYPH_TABLE_PAGE_SIZE + codepoint%GLYPH_TABLE_PAGE_SIZE];
+            if (*entry < 0) *entry = i;
+        }
+        else
+        {
+            unsigned int slot = GlyphTableHash(codepoint) & (table->hashSize - 1);
+
+            while ((table->hashValues[slot] >= 0) && (table->hashKeys[slot] != codepoint)) slot = (slot + 1) & (table->hashSize - 1);
+
+            if (table->hashValues[slot] < 0)
+            {
+                table->hashKeys[slot] = codepoint;
+                table->hashValues[slot] = i;
+            }
+        }
+    }
+
+    TRACELOGD("FONT: Glyph index table built (%i pages | %i hashed glyphs)", pageCount, hashCount);
+
+    return table;
+}
+
+// Unload codepoint to glyph index table
+static void UnloadGlyphTable(rGlyphTable *table)
+{
+    if (table != NULL)
+    {
+        RL_FREE(table->entries);
+        RL_FREE(table->hashKeys);
+        RL_FREE(table->hashValues);
+        RL_FREE(table);
+    }
+}
+#endif      // SUPPORT_GLYPH_INDEX_TABLE
+
 #endif      // SUPPORT_MODULE_RTEXT
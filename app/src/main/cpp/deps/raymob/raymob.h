@@ -56,6 +56,28 @@ extern "C" {
  */
 struct android_app *GetAndroidApp(void);
 
+/**
+ * @brief Sets how long PollInputEvents() blocks when event waiting is enabled.
+ *
+ * This function is defined in 'raylib/platforms/rcore_android.c'.
+ * With EnableEventWaiting(), the first ALooper_pollOnce() call of PollInputEvents()
+ * uses this timeout instead of spinning with a zero timeout.
+ *
+ * @param milliseconds Maximum time to wait for an event, -1 waits forever (default).
+ */
+void SetEventWaitTimeout(int milliseconds);
+
+/**
+ * @brief Checks if a new frame should be rendered.
+ *
+ * This function is defined in 'raylib/platforms/rcore_android.c'.
+ * Returns true if an input event was received or if the OS asked for a redraw
+ * (window created, resized, focus gained...) since the last call.
+ *
+ * @return True if a redraw was requested, the request is reset by the call.
+ */
+bool IsRedrawRequested(void);
+
 
 /* Helper functions */
 
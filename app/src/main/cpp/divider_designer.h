@@ -0,0 +1,144 @@
+#ifndef DIVIDER_DESIGNER_H
+#define DIVIDER_DESIGNER_H
+
+// Voltage divider designer over an E-series: best top/bottom pairs (and optional series trim on
+// the top leg) for a target Vout/Vin ratio, with an optional load across the output.
+// For ratio r the top leg must be k = (1 - r)/r times the effective bottom leg. The effective
+// bottom (bottom || load) grows with the bottom value, so over the sorted value table the
+// required top value only moves forward: one pointer sweep finds the bracketing top values of
+// every bottom value, exhaustive in O(n) instead of testing all n^2 pairs.
+// GPU-free like resistor_decode.h.
+
+#include "e_series.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace resistor {
+
+struct DividerSpec {
+    double ratio;           // Vout/Vin, in (0, 1)
+    double load;            // Ohms across the output, 0 when unloaded
+    bool trim;              // Allow a series trim resistor on the top leg
+};
+
+struct Divider {
+    StandardValue top;
+    StandardValue bottom;
+    StandardValue trim;     // ohms is 0 when no trim is used
+    double ratio;
+    double error;           // Relative to the target ratio, signed
+    double worstError;      // Largest relative error with every part at its tolerance limit
+};
+
+struct DividerResult {
+    std::vector<Divider> byError;
+    std::vector<Divider> byWorstCase;
+};
+
+class DividerDesigner {
+private:
+    ESeries series;
+    std::vector<StandardValue> values;      // Ascending
+
+    static double effectiveBottom(double bottom, double load) {
+        return (load > 0.0) ? bottom*load/(bottom + load) : bottom;
+    }
+
+    static double dividerRatio(double top, double bottom, double load) {
+        double lower = effectiveBottom(bottom, load);
+        return lower/(top + lower);
+    }
+
+    Divider makeDivider(const DividerSpec& spec, size_t top, size_t bottom, const StandardValue* trim) const {
+        Divider divider = {};
+        divider.top = values[top];
+        divider.bottom = values[bottom];
+        if (trim != nullptr) divider.trim = *trim;
+
+        double upper = (double)divider.top.ohms + (double)divider.trim.ohms;
+        double lower = (double)divider.bottom.ohms;
+        divider.ratio = dividerRatio(upper, lower, spec.load);
+        divider.error = (divider.ratio - spec.ratio)/spec.ratio;
+
+        // Extremes are reached with the top leg at one limit and the bottom at the other
+        double tolerance = seriesInfo[series].tolerance/100.0;
+        double highest = dividerRatio(upper*(1.0 - tolerance), lower*(1.0 + tolerance), spec.load);
+        double lowest = dividerRatio(upper*(1.0 + tolerance), lower*(1.0 - tolerance), spec.load);
+        divider.worstError = std::max(std::fabs(highest - spec.ratio), std::fabs(lowest - spec.ratio))/spec.ratio;
+        return divider;
+    }
+
+    // Index of the first value >= ohms
+    size_t lowerBound(double ohms) const {
+        return std::lower_bound(values.begin(), values.end(), ohms,
+            [](const StandardValue& value, double v) { return (double)value.ohms < v; }) - values.begin();
+    }
+
+public:
+    // Values cover the multiplier bands [firstExponent, lastExponent]
+    DividerDesigner(ESeries valueSeries, uint8_t firstExponent = minExponent, uint8_t lastExponent = 6)
+            : series(valueSeries) {
+        const SeriesInfo& info = seriesInfo[series];
+        for (uint8_t exponent = firstExponent; exponent <= lastExponent; exponent++) {
+            for (uint8_t i = 0; i < info.count; i++) {
+                StandardValue value = {};
+                value.significand = seriesSignificand(series, i);
+                value.digitCount = info.digitCount;
+                value.exponent = exponent;
+                value.ohms = (uint64_t)value.significand*powerOf10(exponent);
+                values.push_back(value);
+            }
+        }
+    }
+
+    static double ratioForVoltage(double inputVoltage, double outputVoltage) {
+        return outputVoltage/inputVoltage;
+    }
+
+    DividerResult design(const DividerSpec& spec, size_t topCount) const {
+        DividerResult result;
+        if (!(spec.ratio > 0.0 && spec.ratio < 1.0) || values.empty() || topCount == 0) return result;
+
+        double topPerBottom = (1.0 - spec.ratio)/spec.ratio;
+        std::vector<Divider> candidates;
+        candidates.reserve(values.size()*4);
+
+        // Sweep: first top value >= the required one, never moves back as bottom grows
+        size_t upper = 0;
+        for (size_t bottom = 0; bottom < values.size(); bottom++) {
+            double required = topPerBottom*effectiveBottom((double)values[bottom].ohms, spec.load);
+            while (upper < values.size() && (double)values[upper].ohms < required) upper++;
+
+            if (upper < values.size()) candidates.push_back(makeDivider(spec, upper, bottom, nullptr));
+            if (upper == 0) continue;
+
+            size_t below = upper - 1;
+            candidates.push_back(makeDivider(spec, below, bottom, nullptr));
+
+            // Trim completes the largest top value below the requirement
+            double remainder = required - (double)values[below].ohms;
+            size_t trim = lowerBound(remainder);
+            if (spec.trim && trim < values.size()) candidates.push_back(makeDivider(spec, below, bottom, &values[trim]));
+            if (spec.trim && trim > 0) candidates.push_back(makeDivider(spec, below, bottom, &values[trim - 1]));
+        }
+
+        size_t count = std::min(topCount, candidates.size());
+
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+            [](const Divider& a, const Divider& b) { return std::fabs(a.error) < std::fabs(b.error); });
+        result.byError.assign(candidates.begin(), candidates.begin() + count);
+
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+            [](const Divider& a, const Divider& b) { return a.worstError < b.worstError; });
+        result.byWorstCase.assign(candidates.begin(), candidates.begin() + count);
+
+        return result;
+    }
+};
+
+} // namespace resistor
+
+#endif // DIVIDER_DESIGNER_H
@@ -0,0 +1,239 @@
+#ifndef E_SERIES_H
+#define E_SERIES_H
+
+// Nearest IEC 60063 standard value (E6 to E192) for an arbitrary resistance.
+// Values use the same semantics as the calculator bands: significant digits followed by a
+// power of ten multiplier band, from Black (x1) to White (x1G).
+// Every series stores the log10 of its significands for one decade in a small sorted array
+// (at most 256 floats, padded to a power of two). A query reduces the value to a decade and a
+// log mantissa, then runs a branchless lower bound on that array: no divisions, no table larger
+// than a few cache lines, and the batch version keeps several queries in flight in lockstep.
+// GPU-free like resistor_decode.h.
+
+#include "resistor_decode.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace resistor {
+
+enum ESeries : uint8_t {
+    E6, E12, E24, E48, E96, E192,
+    SeriesCount
+};
+
+// E6 to E24 use two significant digits, E48 to E192 use three
+constexpr std::array<uint16_t, 24> e24Values = {
+    10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 27, 30, 33, 36, 39, 43, 47, 51, 56, 62, 68, 75, 82, 91
+};
+
+constexpr std::array<uint16_t, 192> e192Values = {
+    100, 101, 102, 104, 105, 106, 107, 109, 110, 111, 113, 114, 115, 117, 118, 120, 121, 123, 124, 126,
+    127, 129, 130, 132, 133, 135, 137, 138, 140, 142, 143, 145, 147, 149, 150, 152, 154, 156, 158, 160,
+    162, 164, 165, 167, 169, 172, 174, 176, 178, 180, 182, 184, 187, 189, 191, 193, 196, 198, 200, 203,
+    205, 208, 210, 213, 215, 218, 221, 223, 226, 229, 232, 234, 237, 240, 243, 246, 249, 252, 255, 258,
+    261, 264, 267, 271, 274, 277, 280, 284, 287, 291, 294, 298, 301, 305, 309, 312, 316, 320, 324, 328,
+    332, 336, 340, 344, 348, 352, 357, 361, 365, 370, 374, 379, 383, 388, 392, 397, 402, 407, 412, 417,
+    422, 427, 432, 437, 442, 448, 453, 459, 464, 470, 475, 481, 487, 493, 499, 505, 511, 517, 523, 530,
+    536, 542, 549, 556, 562, 569, 576, 583, 590, 597, 604, 612, 619, 626, 634, 642, 649, 657, 665, 673,
+    681, 690, 698, 706, 715, 723, 732, 741, 750, 759, 768, 777, 787, 796, 806, 816, 825, 835, 845, 856,
+    866, 876, 887, 898, 909, 920, 931, 942, 953, 965, 976, 988
+};
+
+struct SeriesInfo {
+    uint8_t count;          // Values per decade
+    uint8_t stride;         // Step through e24Values or e192Values
+    uint8_t digitCount;     // Significant digits
+    float tolerance;        // Percent
+    const char* toleranceText;
+};
+
+constexpr std::array<SeriesInfo, SeriesCount> seriesInfo = {{
+    { 6, 4, 2, 20.0f, "20%" },
+    { 12, 2, 2, 10.0f, "10%" },
+    { 24, 1, 2, 5.0f, "5%" },
+    { 48, 4, 3, 2.0f, "2%" },
+    { 96, 2, 3, 1.0f, "1%" },
+    { 192, 1, 3, 0.5f, "0.5%" }
+}};
+
+constexpr uint16_t seriesSignificand(ESeries series, uint8_t index)
+{
+    const SeriesInfo& info = seriesInfo[series];
+    return (info.digitCount == 2) ? e24Values[index*info.stride] : e192Values[index*info.stride];
+}
+
+// Multiplier band range, Black to White
+constexpr uint8_t minExponent = 0;
+constexpr uint8_t maxExponent = White;
+
+// Smallest series holding a significand, indexed by the significand written with three digits
+// (two digit values times 10), SeriesCount when it is not a standard value
+constexpr std::array<uint8_t, 1000> makeSeriesMembership()
+{
+    std::array<uint8_t, 1000> table = {};
+    for (uint16_t i = 0; i < 1000; i++) table[i] = SeriesCount;
+    for (uint8_t series = SeriesCount; series-- > 0;) {
+        uint16_t scale = (seriesInfo[series].digitCount == 2) ? 10 : 1;
+        for (uint8_t i = 0; i < seriesInfo[series].count; i++) table[seriesSignificand((ESeries)series, i)*scale] = series;
+    }
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 1000> seriesMembership = makeSeriesMembership();
+
+constexpr uint8_t smallestSeries(uint16_t significand, uint8_t digitCount)
+{
+    uint16_t normalized = (digitCount == 2) ? (uint16_t)(significand*10) : significand;
+    return (normalized < 1000) ? seriesMembership[normalized] : (uint8_t)SeriesCount;
+}
+
+// Every standard value of a series over a range of multiplier bands, ascending
+inline std::vector<double> seriesValues(ESeries series, uint8_t firstExponent = minExponent,
+                                        uint8_t lastExponent = maxExponent)
+{
+    const SeriesInfo& info = seriesInfo[series];
+    std::vector<double> values;
+    values.reserve((size_t)info.count*(lastExponent - firstExponent + 1));
+
+    for (uint8_t exponent = firstExponent; exponent <= lastExponent; exponent++)
+        for (uint8_t i = 0; i < info.count; i++)
+            values.push_back((double)seriesSignificand(series, i)*(double)powerOf10(exponent));
+    return values;
+}
+
+struct StandardValue {
+    uint64_t ohms;
+    uint16_t significand;   // Digit bands read as a number, 2 or 3 digits
+    uint8_t digitCount;
+    uint8_t exponent;       // Multiplier band, ohms = significand*10^exponent
+    float error;            // Relative to the queried value, (ohms - target)/target
+
+    BandColor digit(uint8_t position) const {
+        return (BandColor)((significand/(uint16_t)powerOf10(digitCount - 1 - position))%10);
+    }
+
+    BandColor multiplier() const {
+        return (BandColor)exponent;
+    }
+};
+
+class StandardValueIndex {
+public:
+    static constexpr uint16_t tableSize = 256;  // Power of two above the largest series
+    static constexpr size_t batchWidth = 8;     // Queries searched in lockstep by nearestBatch()
+
+private:
+    // Per series: log10 of each significand normalized to [0, 1), padded with values above 1
+    std::array<std::array<float, tableSize>, SeriesCount> logTables;
+
+    // Index of the first entry >= mantissa, in [0, count]
+    static uint16_t lowerBound(const float* table, float mantissa) {
+        uint16_t pos = 0;
+        for (uint16_t step = tableSize/2; step > 0; step >>= 1)
+            pos += (table[pos + step - 1] < mantissa) ? step : 0;
+        return pos;
+    }
+
+    StandardValue makeValue(ESeries series, int index, int decade, double target) const {
+        const SeriesInfo& info = seriesInfo[series];
+
+        // Past the last significand wraps to the first one of the next decade
+        if (index == info.count) { index = 0; decade++; }
+
+        StandardValue value = {};
+        value.significand = seriesSignificand(series, (uint8_t)index);
+        value.digitCount = info.digitCount;
+        value.exponent = (uint8_t)decade;
+        value.ohms = (uint64_t)value.significand*powerOf10(value.exponent);
+        value.error = (float)(((double)value.ohms - target)/target);
+        return value;
+    }
+
+    // Chooses between the two neighbours of the lower bound, in log space
+    StandardValue resolve(ESeries series, float mantissa, int decade, uint16_t upper, double target) const {
+        const float* table = logTables[series].data();
+        const SeriesInfo& info = seriesInfo[series];
+
+        float upperLog = (upper < info.count) ? table[upper] : 1.0f;
+        float lowerLog = (upper > 0) ? table[upper - 1] : 0.0f;
+        bool takeUpper = (upper == 0) || (upperLog - mantissa < mantissa - lowerLog);
+
+        // The last decade has no next significand to round up to
+        if (upper == info.count && decade == maxExponent) takeUpper = false;
+
+        return makeValue(series, takeUpper ? upper : upper - 1, decade, target);
+    }
+
+    // Splits a value into its multiplier decade and the log10 of its normalized significand
+    static void reduce(const SeriesInfo& info, double target, float& mantissa, int& decade) {
+        double logValue = std::log10((target > 0.0) ? target : 1.0) - (info.digitCount - 1);
+        if (logValue < minExponent) logValue = minExponent;
+        if (logValue >= maxExponent + 1) logValue = maxExponent + 0.9999;
+
+        decade = (int)logValue;
+        mantissa = (float)(logValue - decade);
+    }
+
+public:
+    StandardValueIndex() {
+        for (uint8_t series = 0; series < SeriesCount; series++) {
+            const SeriesInfo& info = seriesInfo[series];
+            float decadeScale = (float)powerOf10(info.digitCount - 1);
+
+            logTables[series].fill(2.0f);
+            for (uint8_t i = 0; i < info.count; i++)
+                logTables[series][i] = std::log10((float)seriesSignificand((ESeries)series, i)/decadeScale);
+        }
+    }
+
+    // Values out of the band range clamp to the smallest or largest standard value
+    StandardValue nearest(ESeries series, double target) const {
+        float mantissa;
+        int decade;
+        reduce(seriesInfo[series], target, mantissa, decade);
+
+        uint16_t upper = lowerBound(logTables[series].data(), mantissa);
+        return resolve(series, mantissa, decade, upper, target);
+    }
+
+    // Same results as nearest() for every value, the searches of a block advance together
+    // so their loads overlap instead of each waiting on the previous one
+    void nearestBatch(ESeries series, const double* targets, StandardValue* results, size_t count) const {
+        const SeriesInfo& info = seriesInfo[series];
+        const float* table = logTables[series].data();
+
+        for (size_t start = 0; start < count; start += batchWidth) {
+            size_t lanes = (count - start < batchWidth) ? count - start : batchWidth;
+
+            float mantissas[batchWidth] = {};
+            int decades[batchWidth] = {};
+            uint16_t positions[batchWidth] = {};
+
+            for (size_t lane = 0; lane < lanes; lane++)
+                reduce(info, targets[start + lane], mantissas[lane], decades[lane]);
+
+            for (uint16_t step = tableSize/2; step > 0; step >>= 1)
+                for (size_t lane = 0; lane < batchWidth; lane++)
+                    positions[lane] += (table[positions[lane] + step - 1] < mantissas[lane]) ? step : 0;
+
+            for (size_t lane = 0; lane < lanes; lane++)
+                results[start + lane] = resolve(series, mantissas[lane], decades[lane], positions[lane], targets[start + lane]);
+        }
+    }
+};
+
+static_assert(seriesSignificand(E6, 5) == 68, "E6 is every fourth E24 value");
+static_assert(seriesSignificand(E12, 11) == 82, "E12 is every second E24 value");
+static_assert(seriesSignificand(E48, 47) == 953, "E48 is every fourth E192 value");
+static_assert(seriesSignificand(E96, 95) == 976, "E96 is every second E192 value");
+static_assert(seriesSignificand(E192, 185) == 920, "E192 keeps the 920 exception of IEC 60063");
+static_assert(smallestSeries(47, 2) == E6 && smallestSeries(82, 2) == E12 && smallestSeries(91, 2) == E24, "two digit values");
+static_assert(smallestSeries(120, 3) == E12 && smallestSeries(105, 3) == E48 && smallestSeries(101, 3) == E192, "three digit values");
+static_assert(smallestSeries(25, 2) == SeriesCount, "not a standard value");
+
+} // namespace resistor
+
+#endif // E_SERIES_H
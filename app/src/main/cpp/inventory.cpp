@@ -0,0 +1,322 @@
+#include "inventory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace resistor {
+
+// Interpolation steps before the binary search takes over
+constexpr int interpolationSteps = 3;
+
+// Monotonic fixed point log2 of a value: exponent in the high bits, 16 mantissa bits below
+static uint32_t logScale(uint64_t value)
+{
+    if (value == 0) return 0;
+    int exponent = 63 - __builtin_clzll(value);
+    uint64_t mantissa = (exponent >= 16) ? (value >> (exponent - 16)) : (value << (16 - exponent));
+    return ((uint32_t)exponent << 16) | (uint32_t)(mantissa & 0xffff);
+}
+
+static void copyLocation(char* destination, const char* location)
+{
+    strncpy(destination, location, inventoryLocationSize - 1);
+    destination[inventoryLocationSize - 1] = '\0';
+}
+
+bool writeInventory(const char* path, std::vector<InventoryEntry> entries)
+{
+    for (InventoryEntry& entry : entries) {
+        if (entry.location.size() >= inventoryLocationSize) entry.location.resize(inventoryLocationSize - 1);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const InventoryEntry& a, const InventoryEntry& b) {
+        return (a.milliohms != b.milliohms) ? a.milliohms < b.milliohms : a.location < b.location;
+    });
+
+    // One record per value and location, empty ones dropped
+    std::vector<uint64_t> keys;
+    std::vector<InventoryRecord> records;
+    std::vector<std::string> locations;
+    keys.reserve(entries.size());
+    records.reserve(entries.size());
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        uint64_t quantity = entries[i].quantity;
+        while (i + 1 < entries.size() && entries[i + 1].milliohms == entries[i].milliohms &&
+               entries[i + 1].location == entries[i].location) quantity += entries[++i].quantity;
+        if (quantity == 0) continue;
+
+        keys.push_back(entries[i].milliohms);
+        records.push_back({ (uint32_t)std::min<uint64_t>(quantity, UINT32_MAX), 0 });
+        locations.push_back(entries[i].location);
+    }
+
+    // Name table: unique names in sorted order
+    std::vector<std::string> names = locations;
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    for (size_t i = 0; i < records.size(); i++) {
+        records[i].location = (uint32_t)(std::lower_bound(names.begin(), names.end(), locations[i]) - names.begin());
+    }
+
+    std::vector<uint32_t> nameOffsets;
+    std::string nameBlob;
+    for (const std::string& name : names) {
+        nameOffsets.push_back((uint32_t)nameBlob.size());
+        nameBlob.append(name);
+        nameBlob.push_back('\0');
+    }
+
+    InventoryHeader header = {};
+    memcpy(header.magic, inventoryMagic, sizeof(header.magic));
+    header.recordCount = (uint32_t)keys.size();
+    header.locationCount = (uint32_t)names.size();
+    header.nameBytes = nameBlob.size();
+
+    std::string temporary = std::string(path) + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr) return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok &= fwrite(keys.data(), sizeof(uint64_t), keys.size(), file) == keys.size();
+    ok &= fwrite(records.data(), sizeof(InventoryRecord), records.size(), file) == records.size();
+    ok &= fwrite(nameOffsets.data(), sizeof(uint32_t), nameOffsets.size(), file) == nameOffsets.size();
+    ok &= fwrite(nameBlob.data(), 1, nameBlob.size(), file) == nameBlob.size();
+    ok &= fclose(file) == 0;
+
+    if (!ok || rename(temporary.c_str(), path) != 0) {
+        remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+Inventory::Inventory()
+    : mapping(nullptr), mappingSize(0), header(nullptr), keys(nullptr), records(nullptr),
+      nameOffsets(nullptr), names(nullptr)
+{
+}
+
+Inventory::~Inventory()
+{
+    close();
+}
+
+bool Inventory::open(const char* path)
+{
+    close();
+    directory = path;
+
+    std::string basePath = directory + "/" + inventoryFileName;
+    int fd = ::open(basePath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        bool ok = fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(InventoryHeader);
+
+        void* data = ok ? mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (data == MAP_FAILED) return false;
+
+        mapping = (const uint8_t*)data;
+        mappingSize = (size_t)info.st_size;
+
+        // Only the header is checked, the sections are used in place
+        const InventoryHeader* candidate = (const InventoryHeader*)mapping;
+        uint64_t expected = sizeof(InventoryHeader) + (uint64_t)candidate->recordCount*(sizeof(uint64_t) + sizeof(InventoryRecord)) +
+                            (uint64_t)candidate->locationCount*sizeof(uint32_t) + candidate->nameBytes;
+        if (memcmp(candidate->magic, inventoryMagic, sizeof(inventoryMagic)) != 0 || expected != mappingSize ||
+            (candidate->nameBytes > 0 && mapping[mappingSize - 1] != '\0')) {
+            close();
+            return false;
+        }
+
+        header = candidate;
+        keys = (const uint64_t*)(mapping + sizeof(InventoryHeader));
+        records = (const InventoryRecord*)(keys + header->recordCount);
+        nameOffsets = (const uint32_t*)(records + header->recordCount);
+        names = (const char*)(nameOffsets + header->locationCount);
+    }
+
+    // Log records written since the last compaction. A torn last record is cut off, so that the
+    // next append starts on a record boundary instead of behind the partial bytes
+    std::string logPath = directory + "/" + inventoryLogFileName;
+    FILE* log = fopen(logPath.c_str(), "rb");
+    if (log != nullptr) {
+        InventoryDelta delta;
+        while (fread(&delta, sizeof(delta), 1, log) == 1) {
+            delta.location[inventoryLocationSize - 1] = '\0';
+            deltas.push_back(delta);
+        }
+        struct stat info;
+        bool torn = (fstat(fileno(log), &info) == 0) && (info.st_size % sizeof(InventoryDelta) != 0);
+        fclose(log);
+        if (torn && truncate(logPath.c_str(), info.st_size - info.st_size % sizeof(InventoryDelta)) != 0) {
+            close();
+            return false;
+        }
+
+        std::stable_sort(deltas.begin(), deltas.end(), [](const InventoryDelta& a, const InventoryDelta& b) {
+            return a.milliohms < b.milliohms;
+        });
+    }
+
+    return true;
+}
+
+void Inventory::close()
+{
+    if (mapping != nullptr) munmap((void*)mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    keys = nullptr;
+    records = nullptr;
+    nameOffsets = nullptr;
+    names = nullptr;
+    deltas.clear();
+}
+
+// First key not below milliohms: the answer stays in [low, high] while interpolating
+size_t Inventory::lowerBound(uint64_t milliohms) const
+{
+    size_t low = 0;
+    size_t high = getRecordCount();
+    uint32_t target = logScale(milliohms);
+
+    for (int step = 0; step < interpolationSteps && high - low > 16; step++) {
+        if (milliohms <= keys[low]) return low;
+        if (milliohms > keys[high - 1]) return high;
+
+        uint32_t first = logScale(keys[low]);
+        uint32_t last = logScale(keys[high - 1]);
+        double fraction = (last > first) ? (double)(target - first)/(double)(last - first) : 0.5;
+        size_t guess = low + (size_t)(fraction*(double)(high - 1 - low));
+
+        if (keys[guess] < milliohms) low = guess + 1;
+        else high = guess;
+    }
+
+    return (size_t)(std::lower_bound(keys + low, keys + high, milliohms) - keys);
+}
+
+void Inventory::insertDelta(const InventoryDelta& delta)
+{
+    auto pos = std::upper_bound(deltas.begin(), deltas.end(), delta, [](const InventoryDelta& a, const InventoryDelta& b) {
+        return a.milliohms < b.milliohms;
+    });
+    deltas.insert(pos, delta);
+}
+
+// Base records of a value with the log changes of their location applied, empty ones dropped
+void Inventory::collect(uint64_t milliohms, std::vector<InventoryMatch>& matches) const
+{
+    std::vector<InventoryMatch> found;
+    std::vector<int64_t> quantities;
+
+    if (header != nullptr) {
+        for (size_t i = lowerBound(milliohms); i < header->recordCount && keys[i] == milliohms; i++) {
+            uint32_t location = records[i].location;
+            uint32_t offset = (location < header->locationCount) ? nameOffsets[location] : 0;
+            found.push_back({ 0, (offset < header->nameBytes) ? names + offset : "" });
+            quantities.push_back(records[i].quantity);
+        }
+    }
+
+    auto delta = std::lower_bound(deltas.begin(), deltas.end(), milliohms, [](const InventoryDelta& a, uint64_t value) {
+        return a.milliohms < value;
+    });
+    for (; delta != deltas.end() && delta->milliohms == milliohms; delta++) {
+        size_t i = 0;
+        while (i < found.size() && strcmp(found[i].location, delta->location) != 0) i++;
+        if (i == found.size()) {
+            found.push_back({ 0, delta->location });
+            quantities.push_back(0);
+        }
+        quantities[i] += delta->change;
+    }
+
+    matches.clear();
+    for (size_t i = 0; i < found.size(); i++) {
+        if (quantities[i] > 0) matches.push_back({ (uint32_t)std::min<int64_t>(quantities[i], UINT32_MAX), found[i].location });
+    }
+}
+
+size_t Inventory::find(uint64_t milliohms, InventoryMatch* matches, size_t capacity) const
+{
+    std::vector<InventoryMatch> found;
+    collect(milliohms, found);
+    std::copy(found.begin(), found.begin() + std::min(capacity, found.size()), matches);
+    return found.size();
+}
+
+uint32_t Inventory::quantity(uint64_t milliohms) const
+{
+    std::vector<InventoryMatch> found;
+    collect(milliohms, found);
+
+    uint64_t total = 0;
+    for (const InventoryMatch& match : found) total += match.quantity;
+    return (uint32_t)std::min<uint64_t>(total, UINT32_MAX);
+}
+
+bool Inventory::record(uint64_t milliohms, int32_t change, const char* location)
+{
+    InventoryDelta delta = {};
+    delta.milliohms = milliohms;
+    delta.change = change;
+    copyLocation(delta.location, location);
+
+    std::string logPath = directory + "/" + inventoryLogFileName;
+    int fd = ::open(logPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+    bool ok = write(fd, &delta, sizeof(delta)) == (ssize_t)sizeof(delta);
+    ::close(fd);
+    if (!ok) return false;
+
+    insertDelta(delta);
+    return true;
+}
+
+bool Inventory::compact()
+{
+    // Values touched by the log are resolved like a lookup, the others are copied from the base
+    std::vector<uint64_t> touched;
+    for (const InventoryDelta& delta : deltas) {
+        if (touched.empty() || touched.back() != delta.milliohms) touched.push_back(delta.milliohms);
+    }
+
+    std::vector<InventoryEntry> entries;
+    if (header != nullptr) {
+        entries.reserve(header->recordCount + deltas.size());
+        for (size_t i = 0; i < header->recordCount; i++) {
+            if (std::binary_search(touched.begin(), touched.end(), keys[i])) continue;
+            uint32_t location = records[i].location;
+            uint32_t offset = (location < header->locationCount) ? nameOffsets[location] : 0;
+            entries.push_back({ keys[i], records[i].quantity, (offset < header->nameBytes) ? names + offset : "" });
+        }
+    }
+
+    std::vector<InventoryMatch> matches;
+    for (uint64_t milliohms : touched) {
+        collect(milliohms, matches);
+        for (const InventoryMatch& match : matches) entries.push_back({ milliohms, match.quantity, match.location });
+    }
+
+    std::string basePath = directory + "/" + inventoryFileName;
+    if (!writeInventory(basePath.c_str(), entries)) return false;
+
+    std::string logPath = directory + "/" + inventoryLogFileName;
+    int fd = ::open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) ::close(fd);
+
+    std::string path = directory;
+    return open(path.c_str());
+}
+
+} // namespace resistor
@@ -0,0 +1,118 @@
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+// Parts inventory: how many resistors of a value are in stock and in which bins.
+// The base file (inventory.bin) is memory-mapped read-only, opening it only checks the header,
+// nothing is parsed. Layout, native little endian:
+//   InventoryHeader | keys: uint64_t milliohms[recordCount], sorted
+//                   | InventoryRecord records[recordCount], same order as the keys
+//                   | uint32_t nameOffsets[locationCount] | NUL terminated location names
+// Lookups are an interpolation search on the keys (values spread over decades, so interpolated
+// on a log scale) finished by binary search. Updates go to an append-only log (inventory.log)
+// of fixed size InventoryDelta records, replayed on open and folded into a new base by compact().
+// GPU-free like resistor_decode.h.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace resistor {
+
+constexpr char inventoryMagic[8] = { 'R', 'E', 'S', 'I', 'N', 'V', '0', '1' };
+constexpr const char* inventoryFileName = "inventory.bin";
+constexpr const char* inventoryLogFileName = "inventory.log";
+
+// Location names are truncated to fit a log record
+constexpr size_t inventoryLocationSize = 28;
+
+struct InventoryHeader {
+    char magic[8];
+    uint32_t recordCount;
+    uint32_t locationCount;
+    uint64_t nameBytes;
+};
+
+struct InventoryRecord {
+    uint32_t quantity;
+    uint32_t location;      // Index in the name table
+};
+
+struct InventoryDelta {
+    uint64_t milliohms;
+    int32_t change;
+    char location[inventoryLocationSize];
+};
+
+static_assert(sizeof(InventoryHeader) == 24, "keys start 8 byte aligned");
+static_assert(sizeof(InventoryDelta) == 40, "log records are 40 bytes");
+
+struct InventoryEntry {
+    uint64_t milliohms;     // Same unit as BandDecode and SmdDecode
+    uint32_t quantity;
+    std::string location;
+};
+
+struct InventoryMatch {
+    uint32_t quantity;
+    const char* location;   // Valid until the inventory is modified or closed
+};
+
+// Writes a base file from entries in any order (temporary file, then renamed over path)
+bool writeInventory(const char* path, std::vector<InventoryEntry> entries);
+
+class Inventory {
+private:
+    std::string directory;
+    const uint8_t* mapping;
+    size_t mappingSize;
+
+    const InventoryHeader* header;
+    const uint64_t* keys;
+    const InventoryRecord* records;
+    const uint32_t* nameOffsets;
+    const char* names;
+
+    std::vector<InventoryDelta> deltas;     // Sorted by value, in log order within a value
+
+    size_t lowerBound(uint64_t milliohms) const;
+    void insertDelta(const InventoryDelta& delta);
+    void collect(uint64_t milliohms, std::vector<InventoryMatch>& matches) const;
+
+public:
+    Inventory();
+    ~Inventory();
+
+    Inventory(const Inventory&) = delete;
+    Inventory& operator=(const Inventory&) = delete;
+
+    // Maps the base file of a directory (e.g. GetCacheDir()) and replays its log, a missing base
+    // is an empty inventory, a torn last log record is cut off. False when the base file is not a
+    // valid inventory or the log cannot be repaired.
+    bool open(const char* path);
+    void close();
+
+    // Locations holding a value, writes up to capacity matches and returns how many there are
+    size_t find(uint64_t milliohms, InventoryMatch* matches, size_t capacity) const;
+
+    // Total in stock over every location
+    uint32_t quantity(uint64_t milliohms) const;
+
+    // Appends a stock change to the log, location names longer than the record are truncated
+    bool record(uint64_t milliohms, int32_t change, const char* location);
+
+    // Folds the log into a new base file, then empties the log
+    bool compact();
+
+    size_t getRecordCount() const {
+        return (header != nullptr) ? header->recordCount : 0;
+    }
+
+    size_t getDeltaCount() const {
+        return deltas.size();
+    }
+};
+
+} // namespace resistor
+
+#endif // INVENTORY_H
@@ -1,17 +1,72 @@
 #include "raymob.h"
 #include "raymath.h"
+#include "band_model.h"
+#include "band_recognition.h"
+#include "inventory.h"
+#include "widget_grid.h"
+#include "alloc_tracker.h"
 #include <array>
-#include <string>
-#include <cmath>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
+#include <cstdlib>
 
 #define MIN(a,b) (((a)<(b))?(a):(b))
+#define MAX(a,b) (((a)>(b))?(a):(b))
 
 constexpr Color bgColor = (Color){16, 20, 44, 255};
 constexpr uint16_t gameScreenWidth = 720;
 constexpr uint16_t gameScreenHeight = 1280;
 
+// On-demand rendering: frames are only produced on input, OS redraw requests or while
+// an animation is in flight, otherwise the loop sleeps in ALooper_pollOnce()
+constexpr bool onDemandRendering = true;
+constexpr int idleWaitTimeout = 1000;           // ms, upper bound for a single idle wait
+constexpr float animationSettleTime = 0.5f;     // s, background keeps animating after an event
+constexpr float maxFrameTime = 1.0f/30.0f;      // s, avoids animation jumps after an idle period
+
+// Rounded rectangles drawn as one antialiased SDF quad each instead of tessellated corners
+constexpr bool sdfRoundedRects = true;
+
+// Text drawn at every size from one small signed distance field atlas instead of a bitmap atlas
+// as large as the largest text, both go through the SDF shapes shader
+constexpr bool sdfText = true;
+constexpr bool shapesShaderLayers = sdfRoundedRects || sdfText;
+
+
+// Background effect is rendered at a fraction of the screen resolution and refresh rate,
+// then upscaled. Pixels hidden by the calculator panel are not shaded at all, but only when the panel
+// is opaque: the translucent panel shows the effect through it, masking would change its color.
+constexpr int backgroundDownscale = 4;
+constexpr float backgroundRate = 15.0f;         // Hz
+constexpr float panelAlpha = 0.8f;
+constexpr bool backgroundMaskPanel = (panelAlpha >= 1.0f);
+
+// Photo picked up at startup from the cache directory, its bands are recognized into the model
+constexpr const char* photoFileName = "resistor.jpg";
+
+// Stock line under the resistor: first locations holding the decoded value, from the inventory
+// mapped from the cache directory (inventory.bin, built on the host with tools/inventory_build)
+constexpr size_t stockLocations = 2;
+
+// Readout text sizes, the strings are shaped into text layouts only when they change
+constexpr float readoutFontSize = 115.0f;
+constexpr float stockFontSize = 40.0f;
+
+// Readout font atlas size, baked on the host (tools/font_bake --sdf) so startup skips TTF rasterization.
+// The TTF is only loaded when the baked asset is missing or was baked at another size or type.
+constexpr int fontBaseSize = sdfText ? 40 : 126;
+
+#if defined(SUPPORT_ALLOC_TRACKING)
+// Frames allowed to allocate after startup (font atlas upload, first batch flushes...)
+constexpr uint32_t allocationWarmupFrames = 3;
+#endif
+
+constexpr Rectangle panelBody = (Rectangle){ 10, 0, gameScreenWidth - 20, gameScreenHeight };
+constexpr float panelRoundness = 0.15f;
+
+
+// Pointer position in virtual layout coordinates, updated once per frame
+Vector2 pointer = { 0 };
+
 
 const char* vertexShader = R"(
 #version 100
@@ -68,12 +123,29 @@ void main() {
 )";
 
 
+constexpr Color unsetBandColor = (Color){80, 80, 80, 127};  // Fade(DARKGRAY, 0.5)
+
+
+void drawRoundedRect(Rectangle rec, float roundness, Color color)
+{
+    if (sdfRoundedRects) DrawRectangleRoundedSDF(rec, roundness, color);
+    else DrawRectangleRounded(rec, roundness, 0, color);
+}
+
+
+void drawRoundedRectLines(Rectangle rec, float roundness, float lineThick, Color color)
+{
+    if (sdfRoundedRects) DrawRectangleRoundedLinesSDF(rec, roundness, lineThick, color);
+    else DrawRectangleRoundedLinesEx(rec, roundness, 0, lineThick, color);
+}
+
+
 struct Band
 {
     Rectangle body;
+    resistor::BandSlot slot;
     Color color;
     bool focused;
-    uint8_t value;
 };
 
 
@@ -91,165 +163,298 @@ public:
         body = (Rectangle){pos.x, pos.y, 120, 120};
     }
 
-    bool isClicked() const {
-        return CheckCollisionPointRec(GetMousePosition(), body) &&
-               IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    // Returns true when the pressed state changed
+    bool setPressed(bool pressed) {
+        bool wasClicked = clicked;
+        clicked = pressed;
+        shrinkFactor = clicked ? shrinkAmount : 0.0f;
+        return clicked != wasClicked;
     }
 
-    void draw() {
+    bool isPressed() const {
+        return clicked;
+    }
+
+    void draw() const {
         Vector2 adjustedPos = {body.x, body.y};
         float adjustedWidth = body.width;
         float adjustedHeight = body.height;
 
-        if (isClicked()) {
-            clicked = true;
-            shrinkFactor = shrinkAmount;
-        }
-        else {
-            clicked = false;
-            shrinkFactor = 0.0f;
-        }
-
         adjustedWidth -= shrinkFactor;
         adjustedHeight -= shrinkFactor;
         adjustedPos.x += shrinkFactor / 2;
         adjustedPos.y += shrinkFactor / 2;
 
-        DrawRectangleRounded((Rectangle){adjustedPos.x, adjustedPos.y, adjustedWidth, adjustedHeight}, 1, 0, Fade(color, 0.8));
+        drawRoundedRect((Rectangle){adjustedPos.x, adjustedPos.y, adjustedWidth, adjustedHeight}, 1, Fade(color, 0.8));
     }
 
     Color getColor() const {
         return color;
     }
+
+    Rectangle getBody() const {
+        return body;
+    }
 };
 
 
 Font globalFont;
 
 
-void drawResistor()
+constexpr Rectangle resistorBody = (Rectangle){ 80, 75, gameScreenWidth - 160, 250 };
+constexpr Rectangle screenBody = (Rectangle){ 275, 400, 375, 200 };
+
+std::array<Button, 10> buttons = {
+        (Button){(Vector2){100, 650}, BLACK},
+        (Button){(Vector2){300, 650}, BROWN},
+        (Button){(Vector2){500, 650}, RED},
+        (Button){(Vector2){100, 850}, ORANGE},
+        (Button){(Vector2){300, 850}, YELLOW},
+        (Button){(Vector2){500, 850}, GREEN},
+        (Button){(Vector2){100, 1050}, BLUE},
+        (Button){(Vector2){300, 1050}, VIOLET},
+        (Button){(Vector2){500, 1050}, GRAY},
+        (Button){(Vector2){100, 450}, WHITE}
+};
+
+std::array<Band, resistor::SlotCount> bands = {
+        (Band){(Rectangle){ resistorBody.x + 50, resistorBody.y, 70, resistorBody.height }, resistor::FirstDigit, unsetBandColor, false},
+        (Band){(Rectangle){ resistorBody.x + 160, resistorBody.y, 70, resistorBody.height }, resistor::SecondDigit, unsetBandColor, false},
+        (Band){(Rectangle){ resistorBody.x + 270, resistorBody.y, 70, resistorBody.height }, resistor::Multiplier, unsetBandColor, false},
+        (Band){(Rectangle){ resistorBody.width - 35, resistorBody.y, 70, resistorBody.height }, resistor::Tolerance, unsetBandColor, false}
+};
+
+resistor::BandModel model;
+
+// Hit-test index over all widgets: buttons first, then bands
+WidgetGrid widgets(gameScreenWidth, gameScreenHeight, 80);
+constexpr int bandWidgetBase = 10;
+static_assert(bandWidgetBase == std::tuple_size<decltype(buttons)>::value, "bands are registered after buttons");
+static_assert(bandWidgetBase + resistor::SlotCount <= WidgetGrid::maxWidgets, "every widget gets a grid id");
+const char* current = resistor::notANumber;
+const char* resistance = resistor::notANumber;
+
+resistor::Inventory inventory;
+char stock[96] = { 0 };
+
+TextLayout currentLayout = { 0 };
+TextLayout resistanceLayout = { 0 };
+TextLayout stockLayout = { 0 };
+
+
+// Static layer: everything that never changes, drawn first
+void drawResistorStatic()
 {
-    constexpr Rectangle body = (Rectangle){ 80, 75, gameScreenWidth - 160, 250 };
+    constexpr Rectangle body = resistorBody;
+
+    drawRoundedRect(panelBody, panelRoundness, Fade(bgColor, panelAlpha));
+
+    //DrawTexturePro(resistor, (Rectangle){0, 0, (float)resistor.width, (float)resistor.height},
+    //               (Rectangle){35, 0, 650, 400}, Vector2Zero(), 0, WHITE);
 
     // left leg
     DrawRectangle(10, (int)(body.y + body.height / 2) - 25, (int)body.x - 30, 50, Fade(RAYWHITE, 0.5));
     // right leg
     DrawRectangle((int)body.width + 100, (int)(body.y + body.height / 2) - 25, (int)body.x - 30, 50, Fade(RAYWHITE, 0.5));
     // outline
-    DrawRectangleRoundedLinesEx(body, 0.15, 0, 20, Fade(RAYWHITE, 0.5));
+    drawRoundedRectLines(body, 0.15, 20, Fade(RAYWHITE, 0.5));
     // body
-    DrawRectangleRounded(body, 0.15, 0, Fade(bgColor, 0.5));
-
-    static std::array<Button, 10> buttons = {
-            (Button){(Vector2){100, 650}, BLACK},
-            (Button){(Vector2){300, 650}, BROWN},
-            (Button){(Vector2){500, 650}, RED},
-            (Button){(Vector2){100, 850}, ORANGE},
-            (Button){(Vector2){300, 850}, YELLOW},
-            (Button){(Vector2){500, 850}, GREEN},
-            (Button){(Vector2){100, 1050}, BLUE},
-            (Button){(Vector2){300, 1050}, VIOLET},
-            (Button){(Vector2){500, 1050}, GRAY},
-            (Button){(Vector2){100, 450}, WHITE}
-    };
-
-    static std::array<Band, 4> bands = {
-            (Band){(Rectangle){ body.x + 50, body.y, 70, body.height }, Fade(DARKGRAY, 0.5), false},
-            (Band){(Rectangle){ body.x + 160, body.y, 70, body.height }, Fade(DARKGRAY, 0.5), false},
-            (Band){(Rectangle){ body.x + 270, body.y, 70, body.height }, Fade(DARKGRAY, 0.5), false},
-            (Band){(Rectangle){ body.width - 35, body.y, 70, body.height }, Fade(DARKGRAY, 0.5), false}
-    };
+    drawRoundedRect(body, 0.15, Fade(bgColor, 0.5));
 
-    static Band* focusedBand = nullptr;
+    // screen
+    drawRoundedRect(screenBody, 0.25, Fade(DARKGRAY, 0.5));
+}
 
-    for (auto& band : bands) {
 
-        if (CheckCollisionPointRec(GetMousePosition(), band.body) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-            if (band.focused) {
-                band.color = Fade(DARKGRAY, 0.5);
-                band.focused = false;
-            }
-            else {
-                focusedBand = &band;
-                band.focused = true;
-                for (auto& b : bands) {
-                    if (&b == &band) continue;
-                    else b.focused = false;
-                }
-            }
-        }
+// Registers every widget in the hit-test index, done once at layout time
+void buildLayout()
+{
+    for (const auto& button : buttons) widgets.add(button.getBody());
+    for (const auto& band : bands) widgets.add(band.body);
+    widgets.build();
+}
 
-        DrawRectangleRec(band.body, Fade(band.color, 0.8));
 
-        if (band.focused) {
-            DrawRectangleLinesEx(band.body, 10, Fade(YELLOW, 1));
-        }
+// Assigns the bands recognized on the photo left in the cache directory, if any.
+// The model holds 4 bands of digit colors, gold/silver bands and longer resistors are only logged.
+void importPhotoBands()
+{
+    char* cacheDir = GetCacheDir();
+    if (cacheDir == NULL) return;
+    const char* fileName = TextFormat("%s/%s", cacheDir, photoFileName);
+    free(cacheDir);
+
+    if (!FileExists(fileName)) return;
+
+    Image photo = LoadImage(fileName);
+    if (photo.data == NULL) return;
+    ImageFormat(&photo, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    // Centroids are the colors of the buttons the bands are drawn with
+    std::array<resistor::RgbColor, resistor::ColorCount> palette;
+    for (size_t i = 0; i < buttons.size(); i++) {
+        Color color = buttons[i].getColor();
+        palette[i] = (resistor::RgbColor){ color.r, color.g, color.b };
     }
 
-    for (uint8_t i = 0; i < buttons.size(); i++) {
+    resistor::BandRecognizer recognizer(palette);
+    resistor::RecognizedBands found = recognizer.recognize((const uint8_t*)photo.data, photo.width, photo.height, photo.width*4);
+    UnloadImage(photo);
 
-        if (focusedBand != nullptr && buttons[i].isClicked()) {
-            focusedBand->value = i;
-            focusedBand->color = buttons[i].getColor();
-        }
+    if (!found.decode.valid) {
+        TraceLog(LOG_WARNING, "PHOTO: No resistor bands recognized in %s", fileName);
+        return;
+    }
+
+    char value[16] = { 0 };
+    resistor::formatMilliohms(found.decode.milliohms, value);
+    TraceLog(LOG_INFO, "PHOTO: %i bands recognized, %s ohm", found.count, value);
 
-        buttons[i].draw();
+    if (found.count > resistor::SlotCount) return;
+    for (uint8_t band = 0; band < found.count; band++) {
+        if (found.colors[band] < resistor::ColorCount) model.assign((resistor::BandSlot)band, (resistor::BandColor)found.colors[band]);
     }
+}
+
+
+// Maps the inventory left in the cache directory, the base file is not parsed
+void openInventory()
+{
+    char* cacheDir = GetCacheDir();
+    if (cacheDir == NULL) return;
+    if (!inventory.open(cacheDir)) TraceLog(LOG_WARNING, "INVENTORY: %s/%s is not a valid inventory", cacheDir, resistor::inventoryFileName);
+    else TraceLog(LOG_INFO, "INVENTORY: %i records, %i pending changes", (int)inventory.getRecordCount(), (int)inventory.getDeltaCount());
+    free(cacheDir);
+}
+
 
-    static std::string current = "NaN";
-    static std::string resistance = "NaN";
+// "12 in Drawer A3, 5 in Box 2", "None in stock", empty without a value or an inventory
+void updateStock()
+{
+    stock[0] = '\0';
+
+    uint64_t milliohms = 0;
+    if (!model.milliohms(milliohms) || (inventory.getRecordCount() == 0 && inventory.getDeltaCount() == 0)) return;
 
-    if (ColorIsEqual(bands[0].color, Fade(DARKGRAY, 0.5)) ||
-        ColorIsEqual(bands[1].color, Fade(DARKGRAY, 0.5)) ||
-        ColorIsEqual(bands[2].color, Fade(DARKGRAY, 0.5))) {
-            current = "NaN";
+    resistor::InventoryMatch matches[stockLocations];
+    size_t found = inventory.find(milliohms, matches, stockLocations);
+    if (found == 0) {
+        snprintf(stock, sizeof(stock), "None in stock");
+        return;
     }
-    else {
-        std::string firstDigit = std::to_string(bands[0].value);
-        std::string secondDigit = std::to_string(bands[1].value);
-        uint8_t base = std::stoi(firstDigit + secondDigit);
-        auto multiplier = (uint64_t)std::pow(10, bands[2].value);
-        uint64_t result = base * multiplier;
-
-        if (result < 1000) current = std::to_string(result);
-        else {
-            const std::array<std::string, 5> suffixes = { "", "k", "M", "B", "T" };
-            uint8_t suffixIndex = 0;
-            auto num = (double)result;
 
-            while (num >= 1000 && suffixIndex < 4) {
-                num /= 1000;
-                suffixIndex++;
-            }
+    int length = 0;
+    for (size_t i = 0; i < MIN(found, stockLocations); i++) {
+        length += snprintf(stock + length, sizeof(stock) - length, "%s%u in %s", (i > 0) ? ", " : "", matches[i].quantity, matches[i].location);
+        if (length >= (int)sizeof(stock)) return;
+    }
+    if (found > stockLocations) snprintf(stock + length, sizeof(stock) - length, " +%i", (int)(found - stockLocations));
+}
 
-            if (num == std::floor(num)) {
-                current = std::to_string((int)num) + suffixes[suffixIndex];
-            }
-            else {
-                std::ostringstream out;
-                out << std::fixed << std::setprecision(2) << num;
-                current = out.str() + suffixes[suffixIndex];
+
+// Handles input and re-derives the readout when a band changed, returns true when it did
+bool updateResistor()
+{
+    static uint32_t decodedVersion = UINT32_MAX;
+    static Band* focusedBand = nullptr;
+    static int pressedButton = WidgetGrid::none;
+
+    // One hit test per frame and only while touching, the touch goes to a single widget
+    int hit = IsMouseButtonDown(MOUSE_BUTTON_LEFT) ? widgets.hitTest(pointer) : WidgetGrid::none;
+
+    if (hit >= bandWidgetBase && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        Band& band = bands[hit - bandWidgetBase];
+
+        if (band.focused) {
+            model.clear(band.slot);
+            band.focused = false;
+        }
+        else {
+            focusedBand = &band;
+            band.focused = true;
+            for (auto& b : bands) {
+                if (&b == &band) continue;
+                else b.focused = false;
             }
         }
     }
 
-    if (ColorIsEqual(bands[3].color, WHITE)) {
-        resistance = "10%";
+    int button = (hit >= 0 && hit < bandWidgetBase) ? hit : WidgetGrid::none;
+
+    if (button != pressedButton) {
+        if (pressedButton != WidgetGrid::none) buttons[pressedButton].setPressed(false);
+        if (button != WidgetGrid::none) buttons[button].setPressed(true);
+        pressedButton = button;
     }
-    else if (ColorIsEqual(bands[3].color, YELLOW)) {
-        resistance = "5%";
+
+    if (focusedBand != nullptr && pressedButton != WidgetGrid::none) {
+        model.assign(focusedBand->slot, (resistor::BandColor)pressedButton);
     }
-    else if (ColorIsEqual(bands[3].color, Fade(DARKGRAY, 0.5))) {
-        resistance = "25%";
+
+    // Only re-derive the strings and band colors when a band changed
+    if (model.getVersion() != decodedVersion) {
+        decodedVersion = model.getVersion();
+        current = model.valueText();
+        resistance = model.toleranceText();
+        updateStock();
+
+        UpdateTextLayout(&currentLayout, globalFont, current, readoutFontSize, 0);
+        UpdateTextLayout(&resistanceLayout, globalFont, resistance, readoutFontSize, 0);
+        UpdateTextLayout(&stockLayout, globalFont, stock, stockFontSize, 0);
+
+        for (auto& band : bands) {
+            band.color = model.isSet(band.slot) ? buttons[model.getColor(band.slot)].getColor() : unsetBandColor;
+        }
+        return true;
     }
-    else {
-        resistance = "NaN";
+    return false;
+}
+
+
+// Dynamic layer: bands, focus outline, pressed buttons and readout
+void drawResistor()
+{
+    for (auto& band : bands) {
+
+        DrawRectangleRec(band.body, Fade(band.color, 0.8));
+
+        if (band.focused) {
+            DrawRectangleLinesEx(band.body, 10, Fade(YELLOW, 1));
+        }
     }
 
-    // screen
-    DrawRectangleRounded((Rectangle){ 275, 400, 375, 200 }, 0.25, 0, Fade(DARKGRAY, 0.5));
-    DrawTextEx(globalFont, current.c_str(), (Vector2){ 340, 400 }, 115, 0, Fade(WHITE, 0.8));
-    DrawTextEx(globalFont, resistance.c_str(), (Vector2){ 340, 480 }, 115, 0, Fade(WHITE, 0.8));
+    for (auto& button : buttons) {
+        button.draw();
+    }
+
+    DrawTextLayout(currentLayout, (Vector2){ 340, 400 }, Fade(WHITE, 0.8));
+    DrawTextLayout(resistanceLayout, (Vector2){ 340, 480 }, Fade(WHITE, 0.8));
+    DrawTextLayout(stockLayout, (Vector2){ resistorBody.x, 340 }, Fade(WHITE, 0.6));
+}
+
+
+
+// Covers the parts of the visible area (in virtual coordinates) not hidden behind the panel:
+// both sides, letterbox bands and the four rounded corners
+void drawBackgroundRegions(Rectangle view)
+{
+    constexpr Rectangle panel = panelBody;
+    constexpr float radius = MIN(panel.width, panel.height)*panelRoundness/2;
+
+    const Rectangle regions[8] = {
+            (Rectangle){ view.x, view.y, panel.x - view.x, view.height },
+            (Rectangle){ panel.x + panel.width, view.y, view.x + view.width - (panel.x + panel.width), view.height },
+            (Rectangle){ panel.x, view.y, panel.width, panel.y - view.y },
+            (Rectangle){ panel.x, panel.y + panel.height, panel.width, view.y + view.height - (panel.y + panel.height) },
+            (Rectangle){ panel.x, panel.y, radius, radius },
+            (Rectangle){ panel.x + panel.width - radius, panel.y, radius, radius },
+            (Rectangle){ panel.x, panel.y + panel.height - radius, radius, radius },
+            (Rectangle){ panel.x + panel.width - radius, panel.y + panel.height - radius, radius, radius }
+    };
+
+    for (const Rectangle& region : regions) {
+        if (region.width > 0 && region.height > 0) DrawRectangleRec(region, WHITE);
+    }
 }
 
 
@@ -259,9 +464,6 @@ int main()
     InitWindow(0, 0, "RESISTORR");
     SetTargetFPS(60);
 
-    RenderTexture2D target = LoadRenderTexture(gameScreenWidth, gameScreenHeight);
-    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
-
     //Texture2D resistor = LoadTexture("resistor.png");
 
     Shader shader = LoadShaderFromMemory(vertexShader, fragmentShader);
@@ -271,50 +473,129 @@ int main()
         return -1;
     }
 
-    globalFont = LoadFontEx("Cubano.ttf", 126, NULL, 0);
+    globalFont = LoadFontEx("Cubano.rfnt", 0, NULL, 0);
+    if (globalFont.baseSize != fontBaseSize || (globalFont.type == FONT_SDF) != sdfText) {
+        UnloadFont(globalFont);
+        globalFont = sdfText ? LoadFontSDF("Cubano.ttf", fontBaseSize, NULL, 0) : LoadFontEx("Cubano.ttf", fontBaseSize, NULL, 0);
+    }
+
+    buildLayout();
+    openInventory();
+    importPhotoBands();
+
+    // Also draws regular shapes and text, stays active for whole layers so SDF quads keep batching
+    Shader shapesShader = LoadShapesShaderSDF();
 
     int resolutionLoc = GetShaderLocation(shader, "resolution");
     int iTimeLoc = GetShaderLocation(shader, "iTime");
 
-    Vector2 resolution = (Vector2){(float)GetScreenWidth(), (float)GetScreenHeight()};
-    SetShaderValue(shader, resolutionLoc, &resolution, SHADER_UNIFORM_VEC2);
+    // Low resolution background target, recreated when the screen size changes
+    RenderTexture2D background = { 0 };
+    float backgroundTimer = 0.0f;
 
     float iTime = 0.0f;
+    float animationTimeLeft = 0.0f;
+
+    SetEventWaitTimeout(idleWaitTimeout);
+
+#if defined(SUPPORT_ALLOC_TRACKING)
+    uint32_t frameIndex = 0;
+    bool steadyFrame = false;
+#endif
 
 
     while (!WindowShouldClose())
     {
-        iTime += GetFrameTime();
-        SetShaderValue(shader, iTimeLoc, &iTime, SHADER_UNIFORM_FLOAT);
+        if (onDemandRendering) {
+            if (IsRedrawRequested()) {
+                animationTimeLeft = animationSettleTime;
+            }
+            else if (animationTimeLeft <= 0.0f) {
+                // Nothing in flight, block until an event arrives instead of drawing a frame
+                EnableEventWaiting();
+                PollInputEvents();
+                DisableEventWaiting();
+                continue;
+            }
+        }
+
+#if defined(SUPPORT_ALLOC_TRACKING)
+        resetAllocationStats();
+        steadyFrame = (++frameIndex > allocationWarmupFrames);
+#endif
+
+        float frameTime = MIN(GetFrameTime(), maxFrameTime);
+        animationTimeLeft -= frameTime;
+
+        iTime += frameTime;
+        backgroundTimer += frameTime;
 
         float scale = MIN((float)GetScreenWidth()/gameScreenWidth, (float)GetScreenHeight()/gameScreenHeight);
 
+        // Maps the virtual layout onto the screen, letterboxed and centered
+        Camera2D camera = { 0 };
+        camera.offset = (Vector2){ ((float)GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f,
+                                   ((float)GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f };
+        camera.zoom = scale;
+
         Vector2 mouse = GetMousePosition();
-        Vector2 virtualMouse = { 0 };
-        virtualMouse.x = (mouse.x - ((float)GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f)/scale;
-        virtualMouse.y = (mouse.y - ((float)GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f)/scale;
-        virtualMouse = Vector2Clamp(virtualMouse, (Vector2){ 0, 0 }, (Vector2){ (float)gameScreenWidth, (float)gameScreenHeight });
+        pointer.x = (mouse.x - camera.offset.x)/scale;
+        pointer.y = (mouse.y - camera.offset.y)/scale;
+        pointer = Vector2Clamp(pointer, (Vector2){ 0, 0 }, (Vector2){ (float)gameScreenWidth, (float)gameScreenHeight });
 
-        SetMouseOffset(static_cast<int>(-((float)GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f),
-                       static_cast<int>(-((float)GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f));
-        SetMouseScale(1/scale, 1/scale);
 
 
+#if defined(SUPPORT_ALLOC_TRACKING)
+        // Re-deriving the readout may grow the text layouts, such frames are not steady-state
+        if (updateResistor()) steadyFrame = false;
+#else
+        updateResistor();
+#endif
 
-        BeginTextureMode(target);
 
-        ClearBackground(BLANK);
 
-        DrawRectangleRounded((Rectangle){10, 0, (float)gameScreenWidth - 20, (float)gameScreenHeight},
-                             0.15, 0, Fade(bgColor, 0.8));
+        int backgroundWidth = MAX(1, GetScreenWidth()/backgroundDownscale);
+        int backgroundHeight = MAX(1, GetScreenHeight()/backgroundDownscale);
 
+        if (background.texture.width != backgroundWidth || background.texture.height != backgroundHeight) {
+            if (background.id != 0) UnloadRenderTexture(background);
+            background = LoadRenderTexture(backgroundWidth, backgroundHeight);
+#if defined(SUPPORT_ALLOC_TRACKING)
+            steadyFrame = false;
+#endif
+            SetTextureFilter(background.texture, TEXTURE_FILTER_BILINEAR);
 
-        //DrawTexturePro(resistor, (Rectangle){0, 0, (float)resistor.width, (float)resistor.height},
-        //               (Rectangle){35, 0, 650, 400}, Vector2Zero(), 0, WHITE);
+            Vector2 resolution = (Vector2){ (float)backgroundWidth, (float)backgroundHeight };
+            SetShaderValue(shader, resolutionLoc, &resolution, SHADER_UNIFORM_VEC2);
+            backgroundTimer = 1.0f/backgroundRate;
+        }
 
-        drawResistor();
+        // Background effect only refreshed at backgroundRate, other frames reuse the texture
+        if (backgroundTimer >= 1.0f/backgroundRate) {
+            backgroundTimer = 0.0f;
+            SetShaderValue(shader, iTimeLoc, &iTime, SHADER_UNIFORM_FLOAT);
 
-        EndTextureMode();
+            BeginTextureMode(background);
+            ClearBackground(BLACK);
+            BeginShaderMode(shader);
+
+            if (backgroundMaskPanel) {
+                Camera2D backgroundCamera = camera;
+                backgroundCamera.offset = Vector2Scale(camera.offset, 1.0f/backgroundDownscale);
+                backgroundCamera.zoom = camera.zoom/backgroundDownscale;
+
+                BeginMode2D(backgroundCamera);
+                drawBackgroundRegions((Rectangle){ -camera.offset.x/scale, -camera.offset.y/scale,
+                                                   (float)GetScreenWidth()/scale, (float)GetScreenHeight()/scale });
+                EndMode2D();
+            }
+            else {
+                DrawRectangle(0, 0, backgroundWidth, backgroundHeight, WHITE);
+            }
+
+            EndShaderMode();
+            EndTextureMode();
+        }
 
 
 
@@ -322,24 +603,34 @@ int main()
 
         ClearBackground(BLACK);
 
-        BeginShaderMode(shader);
+        DrawTexturePro(background.texture, (Rectangle){ 0.0f, 0.0f, (float)backgroundWidth, (float)-backgroundHeight },
+                       (Rectangle){ 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() },
+                       (Vector2){ 0, 0 }, 0.0f, WHITE);
 
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), WHITE);
+        // Virtual layout drawn straight onto the backbuffer, letterboxed and centered by the camera
+        BeginMode2D(camera);
+        if (shapesShaderLayers) BeginShaderMode(shapesShader);
 
-        EndShaderMode();
+        drawResistorStatic();
+        drawResistor();
 
-        DrawTexturePro(target.texture, (Rectangle){ 0.0f, 0.0f, (float)target.texture.width, (float)-target.texture.height },
-                       (Rectangle){((float)GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f,
-                                   ((float)GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f,
-                                   (float)gameScreenWidth*scale, (float)gameScreenHeight*scale},
-                                   (Vector2){ 0, 0 }, 0.0f, WHITE);
+        if (shapesShaderLayers) EndShaderMode();
+        EndMode2D();
 
         EndDrawing();
+
+#if defined(SUPPORT_ALLOC_TRACKING)
+        if (steadyFrame) reportFrameAllocations(frameIndex);
+#endif
     }
 
+    UnloadTextLayout(currentLayout);
+    UnloadTextLayout(resistanceLayout);
+    UnloadTextLayout(stockLayout);
     UnloadFont(globalFont);
+    UnloadShader(shapesShader);
     UnloadShader(shader);
-    UnloadRenderTexture(target);
+    UnloadRenderTexture(background);
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include "network_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace resistor {
+
+// Tasks of the 2+2 search cover this many pairs each
+constexpr size_t pairChunkSize = 4096;
+
+static double combine(double a, double b, char op)
+{
+    return (op == NetworkSeries) ? a + b : a*b/(a + b);
+}
+
+// Value the other branch must have so that a op branch == target, false if none exists
+static bool requiredBranch(double target, double a, char op, double& needed)
+{
+    if (op == NetworkSeries) {
+        needed = target - a;
+        return needed > 0.0;
+    }
+
+    if (a <= target) return false;
+    needed = a*target/(a - target);
+    return true;
+}
+
+// Top-N networks of one part count, sorted by absolute error
+class TopNetworks {
+private:
+    std::vector<Network> networks;
+    size_t capacity;
+
+    static bool sameNetwork(const Network& a, const Network& b) {
+        if (a.partCount != b.partCount || std::fabs(a.ohms - b.ohms) > 1e-9*a.ohms) return false;
+
+        // Unused parts are zero in both, sorting the whole arrays keeps them aligned
+        std::array<double, maxNetworkParts> sortedA = a.parts;
+        std::array<double, maxNetworkParts> sortedB = b.parts;
+        std::sort(sortedA.begin(), sortedA.end());
+        std::sort(sortedB.begin(), sortedB.end());
+        return sortedA == sortedB;
+    }
+
+public:
+    explicit TopNetworks(size_t count) : capacity(count) {
+        networks.reserve(count + 1);
+    }
+
+    double worst() const {
+        return (networks.size() < capacity) ? std::numeric_limits<double>::infinity() : std::fabs(networks.back().error);
+    }
+
+    // Commuted or reassociated copies of a network already listed are dropped
+    void insert(const Network& network) {
+        if (std::fabs(network.error) >= worst()) return;
+        for (const Network& listed : networks) if (sameNetwork(listed, network)) return;
+
+        auto pos = std::upper_bound(networks.begin(), networks.end(), network,
+            [](const Network& a, const Network& b) { return std::fabs(a.error) < std::fabs(b.error); });
+        networks.insert(pos, network);
+        if (networks.size() > capacity) networks.pop_back();
+    }
+
+    void merge(const TopNetworks& other) {
+        for (const Network& network : other.networks) insert(network);
+    }
+
+    const std::vector<Network>& get() const {
+        return networks;
+    }
+};
+
+// Visits indices around the insertion point of needed in a sorted table, nearest first on each
+// side. visit(index) returns false once candidates on that side can no longer enter the top-N.
+template <typename Visit>
+static void walkOutward(size_t count, size_t upper, size_t maxSteps, Visit visit)
+{
+    for (size_t i = upper, steps = 0; i < count && steps < maxSteps; i++, steps++) if (!visit(i)) break;
+    for (size_t i = upper, steps = 0; i > 0 && steps < maxSteps; i--, steps++) if (!visit(i - 1)) break;
+}
+
+size_t Network::describe(char* text, size_t capacity) const
+{
+    constexpr size_t termCapacity = 96;
+    char stack[maxNetworkParts][termCapacity];
+    bool compound[maxNetworkParts] = {};
+    int depth = 0;
+    uint8_t part = 0;
+
+    for (int i = 0; i < partCount*2 - 1; i++) {
+        if (postfix[i] == NetworkPart) {
+            double value = parts[part++];
+            const char* suffix = "";
+            if (value >= 1e9) { value /= 1e9; suffix = "G"; }
+            else if (value >= 1e6) { value /= 1e6; suffix = "M"; }
+            else if (value >= 1e3) { value /= 1e3; suffix = "k"; }
+            snprintf(stack[depth], termCapacity, "%g%s", value, suffix);
+            compound[depth++] = false;
+        }
+        else {
+            char joined[termCapacity];
+            depth -= 2;
+            snprintf(joined, termCapacity, compound[depth] ? "(%s) %c " : "%s %c ", stack[depth], postfix[i]);
+            size_t length = strnlen(joined, termCapacity);
+            snprintf(joined + length, termCapacity - length, compound[depth + 1] ? "(%s)" : "%s", stack[depth + 1]);
+            memcpy(stack[depth], joined, termCapacity);
+            compound[depth++] = true;
+        }
+    }
+
+    int written = snprintf(text, capacity, "%s", (depth > 0) ? stack[0] : "");
+    return (written < 0) ? 0 : std::min((size_t)written, (capacity > 0) ? capacity - 1 : 0);
+}
+
+static_assert(NetworkSolver::maxValues <= UINT16_MAX + 1, "pair entries index values with 16 bits");
+
+NetworkSolver::NetworkSolver(const std::vector<double>& table, WorkPool& workPool) : values(table), pool(workPool)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    values.erase(std::remove_if(values.begin(), values.end(), [](double v) { return !(v > 0.0); }), values.end());
+    if (values.size() > maxValues) values.clear();
+
+    buildPairs();
+}
+
+void NetworkSolver::buildPairs()
+{
+    pairs.clear();
+    pairs.reserve(values.size()*(values.size() + 1));
+
+    for (size_t a = 0; a < values.size(); a++) {
+        for (size_t b = a; b < values.size(); b++) {
+            pairs.push_back({ values[a] + values[b], (uint16_t)a, (uint16_t)b, NetworkSeries });
+            pairs.push_back({ values[a]*values[b]/(values[a] + values[b]), (uint16_t)a, (uint16_t)b, NetworkParallel });
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](const PairEntry& a, const PairEntry& b) { return a.ohms < b.ohms; });
+}
+
+SynthesisResult NetworkSolver::solve(double target, uint8_t maxParts, size_t topCount) const
+{
+    SynthesisResult result;
+    if (!(target > 0.0) || values.empty() || topCount == 0) return result;
+    if (maxParts > maxNetworkParts) maxParts = maxNetworkParts;
+
+    const std::array<char, 2> ops = {{ NetworkSeries, NetworkParallel }};
+    auto pairUpper = [&](double needed) {
+        return (size_t)(std::lower_bound(pairs.begin(), pairs.end(), needed,
+            [](const PairEntry& entry, double v) { return entry.ohms < v; }) - pairs.begin());
+    };
+    auto makeNetwork = [&](double ohms, uint8_t partCount) {
+        Network network = {};
+        network.ohms = ohms;
+        network.error = (ohms - target)/target;
+        network.partCount = partCount;
+        return network;
+    };
+
+    std::vector<TopNetworks> tops(maxParts + 1, TopNetworks(topCount));
+
+    // 1 part: nearest table values
+    if (maxParts >= 1) {
+        size_t upper = std::lower_bound(values.begin(), values.end(), target) - values.begin();
+        walkOutward(values.size(), upper, topCount, [&](size_t i) {
+            Network network = makeNetwork(values[i], 1);
+            if (std::fabs(network.error) >= tops[1].worst()) return false;
+            network.parts[0] = values[i];
+            network.postfix[0] = NetworkPart;
+            tops[1].insert(network);
+            return true;
+        });
+    }
+
+    // 2 parts: nearest memoized pairs
+    if (maxParts >= 2) {
+        walkOutward(pairs.size(), pairUpper(target), topCount, [&](size_t i) {
+            const PairEntry& pair = pairs[i];
+            Network network = makeNetwork(pair.ohms, 2);
+            if (std::fabs(network.error) >= tops[2].worst()) return false;
+            network.parts = {{ values[pair.first], values[pair.second] }};
+            network.postfix = {{ NetworkPart, NetworkPart, pair.op }};
+            tops[2].insert(network);
+            return true;
+        });
+    }
+
+    if (maxParts >= 3) {
+        unsigned workers = pool.getWorkerCount();
+        std::vector<TopNetworks> local3(workers, TopNetworks(topCount));
+        std::vector<TopNetworks> local4(workers, TopNetworks(topCount));
+
+        // Completes r op (pair) with the pairs nearest to the value the pair must have
+        auto searchPairs = [&](double needed, TopNetworks& top, auto makeCandidate) {
+            walkOutward(pairs.size(), pairUpper(needed), topCount, [&](size_t i) {
+                Network network = makeCandidate(pairs[i]);
+                if (std::fabs(network.error) >= top.worst()) return false;
+                top.insert(network);
+                return true;
+            });
+        };
+
+        // 3 parts: r1 op1 (a op2 b), and 4 parts: r1 op1 (r2 op2 (a op3 b)), one task per r1 and op1
+        pool.run(values.size()*ops.size(), [&](size_t task, unsigned worker) {
+            double r1 = values[task/ops.size()];
+            char op1 = ops[task%ops.size()];
+
+            double needed3;
+            if (!requiredBranch(target, r1, op1, needed3)) return;
+
+            searchPairs(needed3, local3[worker], [&](const PairEntry& pair) {
+                Network network = makeNetwork(combine(r1, pair.ohms, op1), 3);
+                network.parts = {{ r1, values[pair.first], values[pair.second] }};
+                network.postfix = {{ NetworkPart, NetworkPart, NetworkPart, pair.op, op1 }};
+                return network;
+            });
+
+            if (maxParts < 4) return;
+
+            // A series branch needs r2 < needed3, a parallel one r2 > needed3
+            size_t split = std::upper_bound(values.begin(), values.end(), needed3) - values.begin();
+            for (char op2 : ops) {
+                size_t first = (op2 == NetworkSeries) ? 0 : split;
+                size_t last = (op2 == NetworkSeries) ? split : values.size();
+
+                for (size_t j = first; j < last; j++) {
+                    double r2 = values[j];
+                    double needed2;
+                    if (!requiredBranch(needed3, r2, op2, needed2)) continue;
+
+                    searchPairs(needed2, local4[worker], [&](const PairEntry& pair) {
+                        Network network = makeNetwork(combine(r1, combine(r2, pair.ohms, op2), op1), 4);
+                        network.parts = {{ r1, r2, values[pair.first], values[pair.second] }};
+                        network.postfix = {{ NetworkPart, NetworkPart, NetworkPart, NetworkPart, pair.op, op2, op1 }};
+                        return network;
+                    });
+                }
+            }
+        });
+
+        // 4 parts: (a op1 b) op0 (c op2 d), one task per chunk of the first pair
+        if (maxParts >= 4) {
+            pool.run((pairs.size() + pairChunkSize - 1)/pairChunkSize, [&](size_t task, unsigned worker) {
+                size_t end = std::min(pairs.size(), (task + 1)*pairChunkSize);
+                for (size_t i = task*pairChunkSize; i < end; i++) {
+                    const PairEntry& left = pairs[i];
+
+                    for (char op0 : ops) {
+                        double needed;
+                        if (!requiredBranch(target, left.ohms, op0, needed)) continue;
+
+                        searchPairs(needed, local4[worker], [&](const PairEntry& right) {
+                            Network network = makeNetwork(combine(left.ohms, right.ohms, op0), 4);
+                            network.parts = {{ values[left.first], values[left.second], values[right.first], values[right.second] }};
+                            network.postfix = {{ NetworkPart, NetworkPart, left.op, NetworkPart, NetworkPart, right.op, op0 }};
+                            return network;
+                        });
+                    }
+                }
+            });
+        }
+
+        for (unsigned worker = 0; worker < workers; worker++) {
+            tops[3].merge(local3[worker]);
+            if (maxParts >= 4) tops[4].merge(local4[worker]);
+        }
+    }
+
+    TopNetworks best(topCount);
+    for (uint8_t parts = 1; parts <= maxParts; parts++) {
+        result.byParts[parts] = tops[parts].get();
+        best.merge(tops[parts]);    // Fewer parts merged first, so they win error ties
+    }
+    result.best = best.get();
+
+    return result;
+}
+
+} // namespace resistor
@@ -0,0 +1,81 @@
+#ifndef NETWORK_SOLVER_H
+#define NETWORK_SOLVER_H
+
+// Series/parallel network synthesis: the best 1 to 4 resistor networks approaching a target
+// value, built from a value table (an E-series from e_series.h or a stock list).
+// Every two resistor sub-network is computed once per table and kept sorted (memoized), larger
+// networks then only search that table: for each outer choice the value the remaining branch
+// must have is solved for and looked up by binary search, walking outwards while candidates can
+// still enter the top-N (branch and bound). Outer choices are spread over a WorkPool.
+// GPU-free like resistor_decode.h.
+
+#include "work_pool.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace resistor {
+
+constexpr uint8_t maxNetworkParts = 4;
+
+enum NetworkToken : char {
+    NetworkPart = 'R',
+    NetworkSeries = '+',
+    NetworkParallel = '|'
+};
+
+struct Network {
+    double ohms;
+    double error;               // Relative to the target, (ohms - target)/target
+    uint8_t partCount;
+    std::array<double, maxNetworkParts> parts;                  // In postfix order
+    std::array<char, 2*maxNetworkParts - 1> postfix;            // NetworkToken, partCount*2 - 1 used
+
+    // Infix description, e.g. "1k + (2.2k | 3.3k)", returns the written length
+    size_t describe(char* text, size_t capacity) const;
+};
+
+struct SynthesisResult {
+    std::array<std::vector<Network>, maxNetworkParts + 1> byParts;  // Top-N per part count, by error
+    std::vector<Network> best;      // Top-N overall, by error then part count
+};
+
+class NetworkSolver {
+private:
+    struct PairEntry {
+        double ohms;
+        uint16_t first;
+        uint16_t second;
+        char op;
+    };
+
+    std::vector<double> values;         // Sorted, unique
+    std::vector<PairEntry> pairs;       // Every 2 part network, sorted by ohms
+    WorkPool& pool;
+
+    void buildPairs();
+
+public:
+    // Distinct values accepted, the pair table holds n(n + 1) entries: about 4.2 million (67 MB)
+    // at the limit, enough for E192 over every multiplier band
+    static constexpr size_t maxValues = 2048;
+
+    // Values must be positive. A table of more than maxValues distinct ones is refused: the
+    // solver is left empty and solve() returns no network.
+    NetworkSolver(const std::vector<double>& table, WorkPool& workPool);
+
+    SynthesisResult solve(double target, uint8_t maxParts, size_t topCount) const;
+
+    size_t getValueCount() const {
+        return values.size();
+    }
+
+    size_t getPairCount() const {
+        return pairs.size();
+    }
+};
+
+} // namespace resistor
+
+#endif // NETWORK_SOLVER_H
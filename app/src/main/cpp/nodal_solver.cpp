@@ -0,0 +1,445 @@
+#include "nodal_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+namespace resistor {
+
+// Resistors per assembly task, and rows per task of the row passes
+constexpr size_t assemblyChunkSize = 65536;
+constexpr size_t rowChunkSize = 16384;
+
+// Nested dissection stops splitting parts of the graph this small
+constexpr size_t dissectionLeafSize = 64;
+
+// Union-find with path halving, nodes merged into the smallest index
+class NodeSets {
+private:
+    std::vector<uint32_t> parent;
+
+public:
+    explicit NodeSets(uint32_t count) : parent(count) {
+        std::iota(parent.begin(), parent.end(), 0u);
+    }
+
+    uint32_t find(uint32_t node) {
+        while (parent[node] != node) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+        return node;
+    }
+
+    void merge(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a < b) parent[b] = a;
+        else parent[a] = b;
+    }
+};
+
+// One end of a resistor as seen from its row, the other end may be a reference node
+struct HalfEdge {
+    uint32_t column;
+    double conductance;
+};
+
+void NodalSolver::assemble(const std::vector<MeshResistor>& resistors, uint32_t rowCount)
+{
+
+    // Entries per row, counted concurrently over chunks of resistors
+    std::unique_ptr<std::atomic<uint32_t>[]> cursors(new std::atomic<uint32_t>[rowCount + 1]);
+    for (size_t row = 0; row <= rowCount; row++) cursors[row].store(0, std::memory_order_relaxed);
+
+    size_t chunkCount = (resistors.size() + assemblyChunkSize - 1)/assemblyChunkSize;
+    auto forEachEnd = [&](size_t task, auto visit) {
+        size_t end = std::min(resistors.size(), (task + 1)*assemblyChunkSize);
+        for (size_t i = task*assemblyChunkSize; i < end; i++) {
+            const MeshResistor& resistor = resistors[i];
+            uint32_t rowA = nodeRow[resistor.a];
+            uint32_t rowB = nodeRow[resistor.b];
+            if (resistor.milliohms == 0 || rowA == rowB) continue;
+
+            double conductance = 1000.0/(double)resistor.milliohms;
+            if (rowA != referenceRow) visit(rowA, HalfEdge{ rowB, conductance });
+            if (rowB != referenceRow) visit(rowB, HalfEdge{ rowA, conductance });
+        }
+    };
+
+    pool.run(chunkCount, [&](size_t task, unsigned) {
+        forEachEnd(task, [&](uint32_t row, const HalfEdge&) { cursors[row + 1].fetch_add(1, std::memory_order_relaxed); });
+    });
+
+    std::vector<uint32_t> edgeStart(rowCount + 1, 0);
+    for (size_t row = 0; row < rowCount; row++) {
+        edgeStart[row + 1] = edgeStart[row] + cursors[row + 1].load(std::memory_order_relaxed);
+        cursors[row].store(edgeStart[row], std::memory_order_relaxed);
+    }
+
+    std::vector<HalfEdge> edges(edgeStart[rowCount]);
+    pool.run(chunkCount, [&](size_t task, unsigned) {
+        forEachEnd(task, [&](uint32_t row, const HalfEdge& edge) {
+            edges[cursors[row].fetch_add(1, std::memory_order_relaxed)] = edge;
+        });
+    });
+
+    // Rows sorted (the order of the concurrent pass is arbitrary), parallel resistors summed,
+    // references only add to the diagonal
+    size_t rowChunks = (rowCount + rowChunkSize - 1)/rowChunkSize;
+    std::vector<uint32_t> rowLength(rowCount + 1, 0);
+
+    pool.run(rowChunks, [&](size_t task, unsigned) {
+        size_t end = std::min<size_t>(rowCount, (task + 1)*rowChunkSize);
+        for (size_t row = task*rowChunkSize; row < end; row++) {
+            HalfEdge* first = edges.data() + edgeStart[row];
+            HalfEdge* last = edges.data() + edgeStart[row + 1];
+            std::sort(first, last, [](const HalfEdge& p, const HalfEdge& q) {
+                return (p.column != q.column) ? p.column < q.column : p.conductance < q.conductance;
+            });
+
+            uint32_t length = 1;
+            for (HalfEdge* edge = first; edge != last; edge++) {
+                if (edge->column != referenceRow && (edge == first || edge->column != edge[-1].column)) length++;
+            }
+            rowLength[row + 1] = length;
+        }
+    });
+
+    rowStart.assign(rowCount + 1, 0);
+    for (size_t row = 0; row < rowCount; row++) rowStart[row + 1] = rowStart[row] + rowLength[row + 1];
+    columns.resize(rowStart[rowCount]);
+    values.resize(rowStart[rowCount]);
+
+    pool.run(rowChunks, [&](size_t task, unsigned) {
+        size_t end = std::min<size_t>(rowCount, (task + 1)*rowChunkSize);
+        for (size_t row = task*rowChunkSize; row < end; row++) {
+            const HalfEdge* first = edges.data() + edgeStart[row];
+            const HalfEdge* last = edges.data() + edgeStart[row + 1];
+
+            double total = 0.0;
+            uint32_t out = rowStart[row];
+            uint32_t diagonal = 0;
+            bool diagonalDone = false;
+            for (const HalfEdge* edge = first; edge != last; edge++) {
+                total += edge->conductance;
+                if (edge->column == referenceRow) continue;
+
+                if (!diagonalDone && edge->column > row) {
+                    diagonal = out;
+                    columns[out++] = (uint32_t)row;
+                    diagonalDone = true;
+                }
+                if (edge != first && edge->column == edge[-1].column) {
+                    values[out - 1] -= edge->conductance;
+                    continue;
+                }
+                columns[out] = edge->column;
+                values[out++] = -edge->conductance;
+            }
+            if (!diagonalDone) {
+                diagonal = out;
+                columns[out++] = (uint32_t)row;
+            }
+            values[diagonal] = total;
+        }
+    });
+}
+
+// Nested dissection of a connected or not set of rows: its connected parts are found in one pass
+// and ordered one after the other, iteratively, so many small parts (e.g. separate resistors)
+// cost no recursion. Only separators recurse, into the two halves they split a part into.
+void NodalSolver::dissect(std::vector<uint32_t>& nodes, std::vector<uint32_t>& label, std::vector<uint32_t>& level,
+                          uint32_t& nextLabel)
+{
+    if (nodes.size() <= dissectionLeafSize) {
+        order.insert(order.end(), nodes.begin(), nodes.end());
+        return;
+    }
+
+    uint32_t id = nextLabel;
+    nextLabel += 2;
+    for (uint32_t node : nodes) label[node] = id;
+
+    // Connected parts, stored one after the other in parts, breadth-first from every row not reached yet
+    std::vector<uint32_t> parts;
+    std::vector<size_t> partStart;
+    parts.reserve(nodes.size());
+    for (uint32_t node : nodes) {
+        if (label[node] != id) continue;
+        partStart.push_back(parts.size());
+        label[node] = id + 1;
+        parts.push_back(node);
+        for (size_t head = partStart.back(); head < parts.size(); head++) {
+            uint32_t row = parts[head];
+            for (uint32_t p = rowStart[row]; p < rowStart[row + 1]; p++) {
+                uint32_t column = columns[p];
+                if (label[column] != id) continue;
+                label[column] = id + 1;
+                parts.push_back(column);
+            }
+        }
+    }
+    partStart.push_back(parts.size());
+    nodes.clear();
+    nodes.shrink_to_fit();
+
+    for (size_t part = 0; part + 1 < partStart.size(); part++) {
+        const uint32_t* first = parts.data() + partStart[part];
+        size_t count = partStart[part + 1] - partStart[part];
+        if (count <= dissectionLeafSize) order.insert(order.end(), first, first + count);
+        else dissectPart(first, count, label, level, nextLabel);
+    }
+}
+
+// Nested dissection of a connected set of rows: a breadth-first level structure from a far away
+// row, the middle level separates the lower and upper levels, both halves are ordered first and
+// the separator last.
+void NodalSolver::dissectPart(const uint32_t* nodes, size_t count, std::vector<uint32_t>& label, std::vector<uint32_t>& level,
+                              uint32_t& nextLabel)
+{
+    uint32_t id = nextLabel;
+    nextLabel += 2;
+    for (size_t i = 0; i < count; i++) label[nodes[i]] = id;
+
+    // Two sweeps: the last row reached from any row is far from everything, start from there
+    std::vector<uint32_t> queue;
+    queue.reserve(count);
+    auto sweep = [&](uint32_t start) {
+        queue.clear();
+        queue.push_back(start);
+        level[start] = 0;
+        label[start] = id + 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t row = queue[head];
+            for (uint32_t p = rowStart[row]; p < rowStart[row + 1]; p++) {
+                uint32_t column = columns[p];
+                if (label[column] != id) continue;
+                label[column] = id + 1;
+                level[column] = level[row] + 1;
+                queue.push_back(column);
+            }
+        }
+        for (uint32_t row : queue) label[row] = id;
+    };
+
+    sweep(nodes[0]);
+    sweep(queue.back());
+
+    uint32_t depth = level[queue.back()];
+    if (depth < 2) {
+        order.insert(order.end(), queue.begin(), queue.end());
+        return;
+    }
+
+    // Middle level: the first one where half of the rows have been reached
+    uint32_t middle = level[queue[queue.size()/2]];
+    middle = std::min(std::max(middle, 1u), depth - 1);
+
+    std::vector<uint32_t> lower, upper, separator;
+    for (uint32_t row : queue) {
+        if (level[row] < middle) lower.push_back(row);
+        else if (level[row] > middle) upper.push_back(row);
+        else separator.push_back(row);
+    }
+    queue.clear();
+    queue.shrink_to_fit();
+
+    // Either half may fall apart into several parts, dissect() orders them one after the other
+    dissect(lower, label, level, nextLabel);
+    dissect(upper, label, level, nextLabel);
+    order.insert(order.end(), separator.begin(), separator.end());
+}
+
+// Up-looking sparse Cholesky of the reordered matrix: the pattern of row k of the factor is the
+// set of rows reached climbing the elimination tree from the entries of row k, counted in a
+// first pass (exact column sizes) and filled in a second one.
+void NodalSolver::factorize()
+{
+    uint32_t rowCount = (uint32_t)order.size();
+    constexpr uint32_t none = UINT32_MAX;
+
+    // Elimination tree, with path compression through ancestor
+    std::vector<uint32_t> parent(rowCount, none);
+    std::vector<uint32_t> ancestor(rowCount, none);
+    for (uint32_t k = 0; k < rowCount; k++) {
+        uint32_t row = order[k];
+        for (uint32_t p = rowStart[row]; p < rowStart[row + 1]; p++) {
+            uint32_t i = position[columns[p]];
+            while (i != none && i < k) {
+                uint32_t next = ancestor[i];
+                ancestor[i] = k;
+                if (next == none) parent[i] = k;
+                i = next;
+            }
+        }
+    }
+
+    // Pattern of row k: stack holds the reached rows in topological order from top
+    std::vector<uint32_t> stack(rowCount);
+    std::vector<uint32_t> mark(rowCount, none);
+    auto reach = [&](uint32_t k) {
+        uint32_t top = rowCount;
+        mark[k] = k;
+        uint32_t row = order[k];
+        for (uint32_t p = rowStart[row]; p < rowStart[row + 1]; p++) {
+            uint32_t i = position[columns[p]];
+            if (i > k) continue;
+            uint32_t length = 0;
+            for (; mark[i] != k; i = parent[i]) {
+                stack[length++] = i;
+                mark[i] = k;
+            }
+            while (length > 0) stack[--top] = stack[--length];
+        }
+        return top;
+    };
+
+    std::vector<size_t> counts(rowCount, 1);
+    for (uint32_t k = 0; k < rowCount; k++) {
+        for (uint32_t top = reach(k); top < rowCount; top++) counts[stack[top]]++;
+    }
+
+    factorStart.assign(rowCount + 1, 0);
+    for (uint32_t k = 0; k < rowCount; k++) factorStart[k + 1] = factorStart[k] + counts[k];
+    factorRows.resize(factorStart[rowCount]);
+    factorValues.resize(factorStart[rowCount]);
+
+    // next[i]: where the next entry of column i goes, after its diagonal
+    std::vector<size_t> next(factorStart.begin(), factorStart.end() - 1);
+    for (uint32_t k = 0; k < rowCount; k++) next[k]++;
+
+    std::fill(mark.begin(), mark.end(), none);
+    std::vector<double> work(rowCount, 0.0);
+
+    for (uint32_t k = 0; k < rowCount; k++) {
+        uint32_t top = reach(k);
+
+        uint32_t row = order[k];
+        for (uint32_t p = rowStart[row]; p < rowStart[row + 1]; p++) {
+            uint32_t i = position[columns[p]];
+            if (i <= k) work[i] = values[p];
+        }
+
+        double original = work[k];
+        double diagonal = original;
+        work[k] = 0.0;
+
+        for (; top < rowCount; top++) {
+            uint32_t i = stack[top];
+            double value = work[i]/factorValues[factorStart[i]];
+            work[i] = 0.0;
+            for (size_t p = factorStart[i] + 1; p < next[i]; p++) work[factorRows[p]] -= factorValues[p]*value;
+            diagonal -= value*value;
+
+            size_t p = next[i]++;
+            factorRows[p] = k;
+            factorValues[p] = value;
+        }
+
+        // Conductance matrices are positive definite, guard against rounding only
+        factorRows[factorStart[k]] = k;
+        factorValues[factorStart[k]] = std::sqrt(std::max(diagonal, original*1e-14));
+    }
+}
+
+void NodalSolver::factor(const ResistorMesh& mesh)
+{
+    const std::vector<MeshResistor>& resistors = mesh.getResistors();
+    uint32_t nodeCount = mesh.getNodeCount();
+
+    // Jumpers merge nodes, any resistor joins parts
+    NodeSets merged(nodeCount);
+    NodeSets parts(nodeCount);
+    for (const MeshResistor& resistor : resistors) {
+        if (resistor.milliohms == 0) merged.merge(resistor.a, resistor.b);
+        parts.merge(resistor.a, resistor.b);
+    }
+
+    // The first merged node of every part is its reference, the others get rows in node order
+    nodeRow.assign(nodeCount, referenceRow);
+    nodePart.resize(nodeCount);
+    std::vector<bool> hasReference(nodeCount, false);
+    uint32_t rowCount = 0;
+
+    for (uint32_t node = 0; node < nodeCount; node++) {
+        uint32_t part = parts.find(node);
+        uint32_t representative = merged.find(node);
+        nodePart[node] = part;
+
+        if (representative != node) {
+            nodeRow[node] = nodeRow[representative];
+        }
+        else if (!hasReference[part]) {
+            hasReference[part] = true;
+        }
+        else {
+            nodeRow[node] = rowCount++;
+        }
+    }
+
+    assemble(resistors, rowCount);
+
+    order.clear();
+    order.reserve(rowCount);
+    std::vector<uint32_t> rows(rowCount);
+    std::iota(rows.begin(), rows.end(), 0u);
+    std::vector<uint32_t> label(rowCount, 0);
+    std::vector<uint32_t> level(rowCount, 0);
+    uint32_t nextLabel = 1;
+    dissect(rows, label, level, nextLabel);
+
+    position.resize(rowCount);
+    for (uint32_t k = 0; k < rowCount; k++) position[order[k]] = k;
+
+    factorize();
+}
+
+double NodalSolver::resistance(uint32_t a, uint32_t b) const
+{
+    if (a >= nodeRow.size() || b >= nodeRow.size()) return (a == b) ? 0.0 : std::numeric_limits<double>::infinity();
+    if (nodePart[a] != nodePart[b]) return std::numeric_limits<double>::infinity();
+
+    uint32_t rowA = nodeRow[a];
+    uint32_t rowB = nodeRow[b];
+    if (rowA == rowB) return 0.0;
+
+    // One ampere in at a and out at b, the answer is the voltage between them
+    uint32_t rowCount = (uint32_t)order.size();
+    uint32_t positionA = (rowA != referenceRow) ? position[rowA] : rowCount;
+    uint32_t positionB = (rowB != referenceRow) ? position[rowB] : rowCount;
+
+    std::vector<double> potential(rowCount, 0.0);
+    if (positionA < rowCount) potential[positionA] = 1.0;
+    if (positionB < rowCount) potential[positionB] = -1.0;
+
+    // Forward substitution, nothing to do before the first injected row
+    for (uint32_t k = std::min(positionA, positionB); k < rowCount; k++) {
+        double value = potential[k]/factorValues[factorStart[k]];
+        potential[k] = value;
+        if (value == 0.0) continue;
+        for (size_t p = factorStart[k] + 1; p < factorStart[k + 1]; p++) potential[factorRows[p]] -= factorValues[p]*value;
+    }
+
+    for (uint32_t k = rowCount; k-- > 0;) {
+        double value = potential[k];
+        for (size_t p = factorStart[k] + 1; p < factorStart[k + 1]; p++) value -= factorValues[p]*potential[factorRows[p]];
+        potential[k] = value/factorValues[factorStart[k]];
+    }
+
+    double voltageA = (positionA < rowCount) ? potential[positionA] : 0.0;
+    double voltageB = (positionB < rowCount) ? potential[positionB] : 0.0;
+    return voltageA - voltageB;
+}
+
+void NodalSolver::resistanceBatch(const std::pair<uint32_t, uint32_t>* ports, double* results, size_t count) const
+{
+    pool.run(count, [&](size_t task, unsigned) {
+        results[task] = resistance(ports[task].first, ports[task].second);
+    });
+}
+
+} // namespace resistor
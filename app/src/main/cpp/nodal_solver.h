@@ -0,0 +1,108 @@
+#ifndef NODAL_SOLVER_H
+#define NODAL_SOLVER_H
+
+// Equivalent resistance between any two nodes of an arbitrary resistor mesh (bridges, ladders,
+// R-2R networks, imported netlists) by nodal analysis.
+// Jumpers merge their nodes, every connected part of the mesh gets one reference node, the
+// remaining conductance matrix is assembled in CSR form over a WorkPool. It is ordered by nested
+// dissection (fill stays near n log n on meshes) and factored once by sparse Cholesky, each port
+// query is then a forward and a backward substitution with that factor. Independent queries
+// run in parallel.
+// GPU-free like resistor_decode.h.
+
+#include "work_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace resistor {
+
+struct MeshResistor {
+    uint32_t a;
+    uint32_t b;
+    uint64_t milliohms;     // Same unit as BandDecode and SmdDecode, 0 is a jumper
+};
+
+class ResistorMesh {
+private:
+    uint32_t nodeCount;
+    std::vector<MeshResistor> resistors;
+
+public:
+    explicit ResistorMesh(uint32_t nodes = 0) : nodeCount(nodes) {}
+
+    void add(uint32_t a, uint32_t b, uint64_t milliohms) {
+        resistors.push_back({ a, b, milliohms });
+        if (a >= nodeCount) nodeCount = a + 1;
+        if (b >= nodeCount) nodeCount = b + 1;
+    }
+
+    uint32_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    const std::vector<MeshResistor>& getResistors() const {
+        return resistors;
+    }
+};
+
+class NodalSolver {
+public:
+    static constexpr uint32_t referenceRow = UINT32_MAX;
+
+private:
+    WorkPool& pool;
+
+    // Node -> row of the reduced system (referenceRow for reference nodes) and connected part
+    std::vector<uint32_t> nodeRow;
+    std::vector<uint32_t> nodePart;
+
+    // Reduced conductance matrix, full symmetric CSR with sorted columns
+    std::vector<uint32_t> rowStart;
+    std::vector<uint32_t> columns;
+    std::vector<double> values;
+
+    // Elimination order (position -> row) and its inverse
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> position;
+
+    // Cholesky factor of the reordered matrix, by columns with the diagonal first
+    std::vector<size_t> factorStart;
+    std::vector<uint32_t> factorRows;
+    std::vector<double> factorValues;
+
+    void assemble(const std::vector<MeshResistor>& resistors, uint32_t rowCount);
+    void dissect(std::vector<uint32_t>& nodes, std::vector<uint32_t>& label, std::vector<uint32_t>& level, uint32_t& nextLabel);
+    void dissectPart(const uint32_t* nodes, size_t count, std::vector<uint32_t>& label, std::vector<uint32_t>& level, uint32_t& nextLabel);
+    void factorize();
+
+public:
+    explicit NodalSolver(WorkPool& workPool) : pool(workPool) {}
+
+    // Assembles and factors the mesh, queries then reuse the factor until the next call
+    void factor(const ResistorMesh& mesh);
+
+    // Ohms between two nodes, infinity when they are not connected
+    // NOTE: Does not use the pool, safe to call from several threads at once
+    double resistance(uint32_t a, uint32_t b) const;
+
+    // One query per port pair, spread over the pool
+    void resistanceBatch(const std::pair<uint32_t, uint32_t>* ports, double* results, size_t count) const;
+
+    uint32_t getRowCount() const {
+        return (uint32_t)order.size();
+    }
+
+    size_t getEntryCount() const {
+        return columns.size();
+    }
+
+    size_t getFactorEntryCount() const {
+        return factorRows.size();
+    }
+};
+
+} // namespace resistor
+
+#endif // NODAL_SOLVER_H
@@ -0,0 +1,150 @@
+#ifndef RESISTOR_DECODE_H
+#define RESISTOR_DECODE_H
+
+// Band -> value -> display string decoding for 4-band resistors.
+// This header is GPU-free on purpose (no raylib), so it can be reused by host tools.
+// Every digit/multiplier/tolerance combination is formatted once at compile time,
+// decoding a band set at runtime is a table lookup and never allocates.
+
+#include <array>
+#include <cstdint>
+
+namespace resistor {
+
+// Color order matches the calculator buttons, a color's index is its digit value
+enum BandColor : uint8_t {
+    Black, Brown, Red, Orange, Yellow, Green, Blue, Violet, Gray, White,
+    ColorCount
+};
+
+// Longest formatted value is 5 characters ("1.20k", "990M"), plus the terminator
+constexpr uint8_t textCapacity = 8;
+
+struct DecodeEntry {
+    uint64_t ohms;
+    char text[textCapacity];
+};
+
+constexpr uint16_t decodeTableSize = ColorCount * ColorCount * ColorCount;
+
+constexpr uint64_t powerOf10(uint8_t exponent)
+{
+    uint64_t result = 1;
+    for (uint8_t i = 0; i < exponent; i++) result *= 10;
+    return result;
+}
+
+constexpr uint64_t decodeOhms(uint8_t first, uint8_t second, uint8_t multiplier)
+{
+    return (uint64_t)(first*10 + second)*powerOf10(multiplier);
+}
+
+// Writes the decimal digits of value at text[pos], returns the new position
+constexpr uint8_t appendNumber(char* text, uint8_t pos, uint64_t value)
+{
+    char digits[20] = {};
+    uint8_t count = 0;
+    do {
+        digits[count++] = (char)('0' + value%10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) text[pos++] = digits[--count];
+    return pos;
+}
+
+// Same rules the calculator always used: plain number below 1000, otherwise scaled down
+// by thousands with a "k"/"M"/"B"/"T" suffix and two decimals when not a whole number.
+// Done in integer arithmetic, a value has at most two significant digits so the two
+// decimals are always exact.
+constexpr DecodeEntry makeEntry(uint8_t first, uint8_t second, uint8_t multiplier)
+{
+    constexpr char suffixes[5] = { '\0', 'k', 'M', 'B', 'T' };
+
+    DecodeEntry entry = {};
+    entry.ohms = decodeOhms(first, second, multiplier);
+
+    uint64_t scale = 1;
+    uint8_t suffixIndex = 0;
+    while (entry.ohms/scale >= 1000 && suffixIndex < 4) {
+        scale *= 1000;
+        suffixIndex++;
+    }
+
+    uint64_t whole = entry.ohms/scale;
+    uint64_t fraction = (entry.ohms%scale)*100/scale;
+
+    uint8_t pos = appendNumber(entry.text, 0, whole);
+    if (fraction != 0) {
+        entry.text[pos++] = '.';
+        entry.text[pos++] = (char)('0' + fraction/10);
+        entry.text[pos++] = (char)('0' + fraction%10);
+    }
+    if (suffixIndex > 0) entry.text[pos++] = suffixes[suffixIndex];
+    entry.text[pos] = '\0';
+
+    return entry;
+}
+
+constexpr uint16_t decodeIndex(uint8_t first, uint8_t second, uint8_t multiplier)
+{
+    return (uint16_t)((first*ColorCount + second)*ColorCount + multiplier);
+}
+
+constexpr std::array<DecodeEntry, decodeTableSize> makeDecodeTable()
+{
+    std::array<DecodeEntry, decodeTableSize> table = {};
+    for (uint8_t first = 0; first < ColorCount; first++)
+        for (uint8_t second = 0; second < ColorCount; second++)
+            for (uint8_t multiplier = 0; multiplier < ColorCount; multiplier++)
+                table[decodeIndex(first, second, multiplier)] = makeEntry(first, second, multiplier);
+    return table;
+}
+
+inline constexpr std::array<DecodeEntry, decodeTableSize> decodeTable = makeDecodeTable();
+
+inline constexpr const char* notANumber = "NaN";
+
+// Tolerance band text indexed by color, ColorCount is used for an unset band
+inline constexpr std::array<const char*, ColorCount + 1> toleranceTable = {
+    notANumber, notANumber, notANumber, notANumber, "5%",
+    notANumber, notANumber, notANumber, notANumber, "10%",
+    "25%"
+};
+
+constexpr const DecodeEntry& decode(uint8_t first, uint8_t second, uint8_t multiplier)
+{
+    return decodeTable[decodeIndex(first, second, multiplier)];
+}
+
+constexpr const char* formatValue(uint8_t first, uint8_t second, uint8_t multiplier)
+{
+    return decode(first, second, multiplier).text;
+}
+
+// Pass ColorCount when the tolerance band is not set
+constexpr const char* formatTolerance(uint8_t color)
+{
+    return toleranceTable[color < ColorCount ? color : (uint8_t)ColorCount];
+}
+
+constexpr bool textEqual(const char* a, const char* b)
+{
+    while (*a != '\0' && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+static_assert(decode(0, 0, Black).ohms == 0, "black-black-black is 0 ohms");
+static_assert(decode(White, White, White).ohms == 99000000000ULL, "largest value is 99G ohms");
+static_assert(textEqual(formatValue(Brown, Black, Black), "10"), "values below 1000 are plain");
+static_assert(textEqual(formatValue(Violet, Green, Brown), "750"), "values below 1000 are plain");
+static_assert(textEqual(formatValue(Brown, Red, Red), "1.20k"), "fractional values use two decimals");
+static_assert(textEqual(formatValue(Yellow, Violet, Red), "4.70k"), "fractional values use two decimals");
+static_assert(textEqual(formatValue(Brown, Black, Orange), "10k"), "whole values drop decimals");
+static_assert(textEqual(formatValue(Brown, Green, Green), "1.50M"), "megaohm suffix");
+static_assert(textEqual(formatValue(White, White, White), "99B"), "billion suffix");
+static_assert(textEqual(formatTolerance(Yellow), "5%"), "yellow tolerance band");
+static_assert(textEqual(formatTolerance(ColorCount), "25%"), "unset tolerance band");
+
+} // namespace resistor
+
+#endif // RESISTOR_DECODE_H
@@ -0,0 +1,150 @@
+#ifndef SMD_DECODE_H
+#define SMD_DECODE_H
+
+// SMD resistor marking decoder: 3-digit ("472"), 4-digit ("4702"), R-notation ("4R7", "R010")
+// and EIA-96 ("01C"), plus zero ohm jumpers ("0", "000").
+// Every character goes through one constexpr class table (digit value, decimal mark, EIA-96
+// letter), the code shape then picks the formula. Values are integer milliohms like band_layout.h.
+// NOTE: "47R" is read as R-notation (47 ohms), EIA-96 codes use Y for x0.01 and X for x0.1.
+// GPU-free like resistor_decode.h.
+
+#include "e_series.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace resistor {
+
+enum SmdKind : uint8_t {
+    SmdInvalid,
+    SmdJumper,
+    SmdThreeDigit,
+    SmdFourDigit,
+    SmdRNotation,
+    SmdEia96
+};
+
+struct SmdDecode {
+    uint64_t milliohms;
+    uint16_t tolerance;     // Usual tolerance of the marking in hundredths of a percent, 0 if unknown
+    SmdKind kind;
+};
+
+enum SmdCharClass : uint8_t {
+    SmdDigit = 0x10,        // Low nibble holds the digit value
+    SmdDecimal = 0x20,      // R, the decimal point of R-notation
+    SmdLetter = 0x40,       // EIA-96 multiplier letter, low nibble indexes smdLetterScale
+    SmdOther = 0x00
+};
+
+// EIA-96 multiplier in milliohms: Z, Y, X, S, A, B, H, C, D, E, F
+constexpr std::array<uint32_t, 11> smdLetterScale = {
+    1, 10, 100, 100, 1000, 10000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+constexpr std::array<uint8_t, 256> makeSmdCharClasses()
+{
+    constexpr char letters[11] = { 'Z', 'Y', 'X', 'S', 'A', 'B', 'H', 'C', 'D', 'E', 'F' };
+
+    std::array<uint8_t, 256> classes = {};
+    for (uint8_t digit = 0; digit < 10; digit++) classes['0' + digit] = SmdDigit | digit;
+    classes['R'] = classes['r'] = SmdDecimal;
+    for (uint8_t i = 0; i < 11; i++) {
+        classes[(uint8_t)letters[i]] = SmdLetter | i;
+        classes[(uint8_t)(letters[i] | 0x20)] = SmdLetter | i;
+    }
+    return classes;
+}
+
+inline constexpr std::array<uint8_t, 256> smdCharClasses = makeSmdCharClasses();
+
+constexpr uint8_t smdMaxLength = 4;
+
+// Decodes up to smdMaxLength characters, shorter codes end at length or at a NUL
+constexpr SmdDecode decodeSmd(const char* text, size_t length)
+{
+    SmdDecode result = {};
+
+    // Class of each position, padded with SmdOther
+    uint8_t classes[smdMaxLength] = {};
+    uint8_t count = 0;
+    while (count < length && count < smdMaxLength && text[count] != '\0') {
+        classes[count] = smdCharClasses[(uint8_t)text[count]];
+        count++;
+    }
+    if (count < length && text[count] != '\0') return result;   // Longer than any marking
+
+    // Shape: which positions are digits, the decimal mark and a letter
+    uint8_t digitMask = 0;
+    uint8_t decimalMask = 0;
+    uint8_t letterMask = 0;
+    uint64_t digits = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t isDigit = (classes[i] & SmdDigit) ? 1 : 0;
+        digitMask |= (uint8_t)(isDigit << i);
+        decimalMask |= (uint8_t)(((classes[i] & SmdDecimal) ? 1 : 0) << i);
+        letterMask |= (uint8_t)(((classes[i] & SmdLetter) ? 1 : 0) << i);
+        digits = isDigit ? digits*10 + (classes[i] & 0x0f) : digits;
+    }
+
+    uint8_t allDigits = (uint8_t)((1u << count) - 1);
+
+    if (count > 0 && digitMask == allDigits && digits == 0) {
+        result.kind = SmdJumper;
+    }
+    else if (count == 3 && digitMask == allDigits) {
+        result.kind = SmdThreeDigit;
+        result.milliohms = (digits/10)*powerOf10((uint8_t)(digits%10 + 3));
+        result.tolerance = 500;
+    }
+    else if (count == 4 && digitMask == allDigits) {
+        result.kind = SmdFourDigit;
+        result.milliohms = (digits/10)*powerOf10((uint8_t)(digits%10 + 3));
+        result.tolerance = 100;
+    }
+    else if (count >= 2 && decimalMask != 0 && (decimalMask & (decimalMask - 1)) == 0 &&
+             (digitMask | decimalMask) == allDigits) {
+        // Digits after R are decimals, at most 3 of them in milliohms
+        uint8_t position = 0;
+        while (((decimalMask >> position) & 1) == 0) position++;
+        uint8_t decimals = (uint8_t)(count - 1 - position);
+        result.kind = SmdRNotation;
+        result.milliohms = digits*powerOf10((uint8_t)(3 - decimals));
+    }
+    else if (count == 3 && digitMask == 0x3 && letterMask == 0x4 && digits >= 1 && digits <= 96) {
+        result.kind = SmdEia96;
+        result.milliohms = (uint64_t)seriesSignificand(E96, (uint8_t)(digits - 1))*smdLetterScale[classes[2] & 0x0f];
+        result.tolerance = 100;
+    }
+
+    return result;
+}
+
+// Codes stored back to back, stride bytes each, NUL padded when shorter than the stride
+inline void decodeSmdBatch(const char* codes, size_t stride, SmdDecode* results, size_t count)
+{
+    for (size_t i = 0; i < count; i++) results[i] = decodeSmd(codes + i*stride, stride);
+}
+
+constexpr bool smdCheck(const char* text, SmdKind kind, uint64_t milliohms)
+{
+    SmdDecode result = decodeSmd(text, 8);
+    return result.kind == kind && result.milliohms == milliohms;
+}
+
+static_assert(smdCheck("472", SmdThreeDigit, 4700000), "3-digit");
+static_assert(smdCheck("100", SmdThreeDigit, 10000), "3-digit, x1");
+static_assert(smdCheck("4702", SmdFourDigit, 47000000), "4-digit");
+static_assert(smdCheck("4R7", SmdRNotation, 4700), "R-notation");
+static_assert(smdCheck("R010", SmdRNotation, 10), "R-notation, milliohms");
+static_assert(smdCheck("47R", SmdRNotation, 47000), "R-notation wins over EIA-96");
+static_assert(smdCheck("01C", SmdEia96, 10000000), "EIA-96 100 x100");
+static_assert(smdCheck("68x", SmdEia96, 49900), "EIA-96 499 x0.1, lowercase");
+static_assert(smdCheck("000", SmdJumper, 0), "jumper");
+static_assert(smdCheck("97A", SmdInvalid, 0), "EIA-96 index past 96");
+static_assert(smdCheck("R4R", SmdInvalid, 0), "two decimal marks");
+static_assert(smdCheck("R0001", SmdInvalid, 0), "too long");
+
+} // namespace resistor
+
+#endif // SMD_DECODE_H
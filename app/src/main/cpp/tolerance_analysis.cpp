@@ -0,0 +1,207 @@
+#include "tolerance_analysis.h"
+
+#include "external/rprand.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace resistor {
+
+// Partial statistics of one task, deviations are taken from the nominal value
+struct TaskStats {
+    uint64_t count;
+    uint64_t inSpec;
+    double sum;
+    double sumSquares;
+    double minimum;
+    double maximum;
+};
+
+// Fills deviations with samples in [-1, 1), or standard normal ones for GaussianTolerance/3
+static void drawDeviations(rprand_batch& random, ToleranceDistribution distribution, float* deviations, size_t count)
+{
+    // Whole pairs for Box-Muller, blockSize is even so an odd count still fits
+    static_assert(ToleranceAnalyzer::blockSize%2 == 0, "Box-Muller draws pairs");
+    unsigned int bits[ToleranceAnalyzer::blockSize];
+    size_t drawn = (distribution == GaussianTolerance) ? (count + 1)/2*2 : count;
+    rprand_batch_fill(&random, bits, (unsigned int)drawn);
+
+    if (distribution == UniformTolerance) {
+        for (size_t i = 0; i < count; i++) deviations[i] = (float)(bits[i] >> 8)*(2.0f/16777216.0f) - 1.0f;
+        return;
+    }
+
+    // Box-Muller on pairs, scaled so the tolerance is 3 sigma. With an odd count the second value
+    // of the last pair is dropped, every sample is still drawn.
+    for (size_t i = 0; i < count; i += 2) {
+        float u1 = ((float)(bits[i] >> 8) + 1.0f)*(1.0f/16777216.0f);
+        float u2 = (float)(bits[i + 1] >> 8)*(1.0f/16777216.0f);
+        float radius = std::sqrt(-2.0f*std::log(u1))*(1.0f/3.0f);
+        deviations[i] = radius*std::cos(6.28318531f*u2);
+        if (i + 1 < count) deviations[i + 1] = radius*std::sin(6.28318531f*u2);
+    }
+}
+
+// Evaluates the circuit for every sample of a block, values holds one array per part
+static void evaluateBlock(const uint8_t partCount, const std::array<char, 2*maxNetworkParts - 1>& postfix,
+                          bool divider, double load, double values[][ToleranceAnalyzer::blockSize],
+                          double* results, size_t count)
+{
+    if (divider) {
+        const double* top = values[0];
+        const double* trim = values[1];
+        const double* bottom = values[2];
+        for (size_t i = 0; i < count; i++) {
+            double lower = (load > 0.0) ? bottom[i]*load/(bottom[i] + load) : bottom[i];
+            results[i] = lower/(top[i] + trim[i] + lower);
+        }
+        return;
+    }
+
+    double stack[maxNetworkParts][ToleranceAnalyzer::blockSize];
+    int depth = 0;
+    uint8_t part = 0;
+
+    for (int token = 0; token < partCount*2 - 1; token++) {
+        if (postfix[token] == NetworkPart) {
+            std::copy(values[part], values[part] + count, stack[depth]);
+            part++;
+            depth++;
+            continue;
+        }
+
+        double* a = stack[depth - 2];
+        const double* b = stack[depth - 1];
+        if (postfix[token] == NetworkSeries) for (size_t i = 0; i < count; i++) a[i] = a[i] + b[i];
+        else for (size_t i = 0; i < count; i++) a[i] = a[i]*b[i]/(a[i] + b[i]);
+        depth--;
+    }
+
+    std::copy(stack[0], stack[0] + count, results);
+}
+
+AnalysisResult ToleranceAnalyzer::run(const Circuit& circuit, const AnalysisSpec& spec) const
+{
+    AnalysisResult result = {};
+
+    // Nominal output, evaluated like any other sample
+    double nominalValues[maxNetworkParts][blockSize];
+    for (uint8_t part = 0; part < circuit.partCount; part++) nominalValues[part][0] = circuit.nominal[part];
+    evaluateBlock(circuit.partCount, circuit.postfix, circuit.divider, circuit.load, nominalValues, &result.nominal, 1);
+
+    if (spec.samples == 0) return result;
+
+    result.histogramMin = spec.histogramMin;
+    result.histogramMax = spec.histogramMax;
+    if (result.histogramMin == 0.0 && result.histogramMax == 0.0) {
+        // Sensitivity of a series/parallel network or a divider ratio to any part is at most 1
+        double spread = 0.0;
+        for (uint8_t part = 0; part < circuit.partCount; part++) if (circuit.nominal[part] > 0.0) spread += circuit.tolerance[part];
+        if (spec.distribution == GaussianTolerance) spread *= 4.0/3.0;     // Up to 4 sigma
+        result.histogramMin = result.nominal*(1.0 - spread);
+        result.histogramMax = result.nominal*(1.0 + spread);
+    }
+
+    uint16_t bins = (spec.histogramBins > 0) ? spec.histogramBins : 1;
+    double binScale = (result.histogramMax > result.histogramMin) ? bins/(result.histogramMax - result.histogramMin) : 0.0;
+
+    size_t taskCount = (size_t)((spec.samples + taskSamples - 1)/taskSamples);
+    std::vector<TaskStats> stats(taskCount);
+    std::vector<uint32_t> histograms(taskCount*bins, 0);
+
+    pool.run(taskCount, [&](size_t task, unsigned) {
+        rprand_batch random;
+        rprand_batch_set_seed(&random, spec.seed ^ (0x9e3779b97f4a7c15ULL*(task + 1)));
+
+        TaskStats& local = stats[task];
+        local = { 0, 0, 0.0, 0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+        uint32_t* histogram = &histograms[task*bins];
+
+        uint64_t first = (uint64_t)task*taskSamples;
+        uint64_t samples = std::min(taskSamples, spec.samples - first);
+
+        float deviations[blockSize];
+        double values[maxNetworkParts][blockSize];
+        double results[blockSize];
+
+        for (uint64_t done = 0; done < samples; done += blockSize) {
+            size_t count = (size_t)std::min<uint64_t>(blockSize, samples - done);
+
+            for (uint8_t part = 0; part < circuit.partCount; part++) {
+                drawDeviations(random, spec.distribution, deviations, count);
+                double nominal = circuit.nominal[part];
+                float tolerance = circuit.tolerance[part];
+                for (size_t i = 0; i < count; i++) values[part][i] = nominal*(1.0 + (double)(tolerance*deviations[i]));
+            }
+
+            evaluateBlock(circuit.partCount, circuit.postfix, circuit.divider, circuit.load, values, results, count);
+
+            for (size_t i = 0; i < count; i++) {
+                double value = results[i];
+                double deviation = value - result.nominal;
+                local.sum += deviation;
+                local.sumSquares += deviation*deviation;
+                local.minimum = std::min(local.minimum, value);
+                local.maximum = std::max(local.maximum, value);
+                local.inSpec += (value >= spec.specMin && value <= spec.specMax) ? 1 : 0;
+
+                int bin = (int)((value - result.histogramMin)*binScale);
+                histogram[std::min(std::max(bin, 0), bins - 1)]++;
+            }
+            local.count += count;
+        }
+    });
+
+    // Merged in task order, identical for any number of workers
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    uint64_t inSpec = 0;
+    result.minimum = std::numeric_limits<double>::infinity();
+    result.maximum = -std::numeric_limits<double>::infinity();
+    result.histogram.assign(bins, 0);
+
+    for (size_t task = 0; task < taskCount; task++) {
+        sum += stats[task].sum;
+        sumSquares += stats[task].sumSquares;
+        inSpec += stats[task].inSpec;
+        result.minimum = std::min(result.minimum, stats[task].minimum);
+        result.maximum = std::max(result.maximum, stats[task].maximum);
+        for (uint16_t bin = 0; bin < bins; bin++) result.histogram[bin] += histograms[task*bins + bin];
+    }
+
+    double count = (double)spec.samples;
+    double meanDeviation = sum/count;
+    result.mean = result.nominal + meanDeviation;
+    result.sigma = std::sqrt(std::max(0.0, sumSquares/count - meanDeviation*meanDeviation));
+    result.yield = (double)inSpec/count;
+
+    return result;
+}
+
+AnalysisResult ToleranceAnalyzer::analyze(const Network& network, const std::array<float, maxNetworkParts>& tolerances,
+                                          const AnalysisSpec& spec) const
+{
+    Circuit circuit = {};
+    circuit.partCount = network.partCount;
+    circuit.nominal = network.parts;
+    circuit.postfix = network.postfix;
+    for (uint8_t part = 0; part < network.partCount; part++) circuit.tolerance[part] = tolerances[part]/100.0f;
+
+    return run(circuit, spec);
+}
+
+AnalysisResult ToleranceAnalyzer::analyze(const Divider& divider, ESeries series, double load, const AnalysisSpec& spec) const
+{
+    float tolerance = seriesInfo[series].tolerance/100.0f;
+
+    Circuit circuit = {};
+    circuit.partCount = 3;
+    circuit.nominal = {{ (double)divider.top.ohms, (double)divider.trim.ohms, (double)divider.bottom.ohms }};
+    circuit.tolerance = {{ tolerance, tolerance, tolerance }};
+    circuit.divider = true;
+    circuit.load = load;
+
+    return run(circuit, spec);
+}
+
+} // namespace resistor
@@ -0,0 +1,82 @@
+#ifndef TOLERANCE_ANALYSIS_H
+#define TOLERANCE_ANALYSIS_H
+
+// Monte Carlo tolerance analysis of a series/parallel network (network_solver.h) or a divider
+// (divider_designer.h): every sample draws each part within its tolerance and evaluates the
+// circuit, then mean, sigma, histogram and yield against a spec window are reported.
+// Samples are processed in blocks, one array per part, drawn by the lane-interleaved rprand
+// batch generator (Xoshiro128**). Work is cut in fixed-size tasks seeded from (seed, task index)
+// and merged in task order, so results only depend on the seed, never on the thread count.
+
+#include "divider_designer.h"
+#include "network_solver.h"
+#include "work_pool.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace resistor {
+
+enum ToleranceDistribution : uint8_t {
+    UniformTolerance,       // Flat within +-tolerance
+    GaussianTolerance       // Normal, tolerance is 3 sigma
+};
+
+struct AnalysisSpec {
+    uint64_t samples;
+    uint64_t seed;
+    double specMin;             // Yield window, in ohms (network) or as a ratio (divider)
+    double specMax;
+    uint16_t histogramBins;
+    double histogramMin;        // Both 0 picks nominal +- the sum of the tolerances
+    double histogramMax;
+    ToleranceDistribution distribution;
+};
+
+struct AnalysisResult {
+    double nominal;
+    double mean;
+    double sigma;
+    double minimum;
+    double maximum;
+    double yield;               // Fraction of samples within [specMin, specMax]
+    double histogramMin;
+    double histogramMax;
+    std::vector<uint32_t> histogram;    // Out of range samples land in the first or last bin
+};
+
+class ToleranceAnalyzer {
+public:
+    static constexpr size_t blockSize = 256;        // Samples evaluated together
+    static constexpr uint64_t taskSamples = 65536;  // Samples per seeded task
+
+private:
+    // Parts of the circuit and how they combine: a postfix network, or a divider
+    struct Circuit {
+        uint8_t partCount;
+        std::array<double, maxNetworkParts> nominal;
+        std::array<float, maxNetworkParts> tolerance;   // Relative
+        std::array<char, 2*maxNetworkParts - 1> postfix;
+        bool divider;           // Parts are top, trim, bottom
+        double load;
+    };
+
+    WorkPool& pool;
+
+    AnalysisResult run(const Circuit& circuit, const AnalysisSpec& spec) const;
+
+public:
+    explicit ToleranceAnalyzer(WorkPool& workPool) : pool(workPool) {}
+
+    // Tolerances in percent, one per part in postfix order
+    AnalysisResult analyze(const Network& network, const std::array<float, maxNetworkParts>& tolerances,
+                           const AnalysisSpec& spec) const;
+
+    // Parts use their series tolerance, the load is exact
+    AnalysisResult analyze(const Divider& divider, ESeries series, double load, const AnalysisSpec& spec) const;
+};
+
+} // namespace resistor
+
+#endif // TOLERANCE_ANALYSIS_H
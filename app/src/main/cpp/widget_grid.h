@@ -0,0 +1,87 @@
+#ifndef WIDGET_GRID_H
+#define WIDGET_GRID_H
+
+// Uniform grid index over widget bounds, built once at layout time.
+// A hit test looks up the cell under the point and only checks the few widgets
+// overlapping that cell, so its cost does not depend on the number of widgets.
+// Only raylib types are used, no drawing or input calls, so it also runs headless.
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class WidgetGrid {
+private:
+    float cellSize;
+    int columns;
+    int rows;
+    std::vector<Rectangle> bounds;
+    std::vector<uint32_t> cellStart;    // Per cell offset into cellWidgets, columns*rows + 1 entries
+    std::vector<uint16_t> cellWidgets;  // Widget ids overlapping each cell, in insertion order
+
+    int cellCoord(float value, int count) const {
+        int cell = (int)(value/cellSize);
+        return (cell < 0) ? 0 : ((cell >= count) ? count - 1 : cell);
+    }
+
+public:
+    static constexpr int none = -1;
+    static constexpr size_t maxWidgets = (size_t)UINT16_MAX + 1;    // Ids are stored in 16 bits
+
+    WidgetGrid(float width, float height, float cell)
+            : cellSize(cell), columns((int)(width/cell) + 1), rows((int)(height/cell) + 1) {}
+
+    // Returns the widget id, ids are given in registration order, none past maxWidgets
+    int add(Rectangle widgetBounds) {
+        if (bounds.size() >= maxWidgets) return none;
+        bounds.push_back(widgetBounds);
+        return (int)bounds.size() - 1;
+    }
+
+    // Assigns every registered widget to the cells it overlaps, false if the cells hold more
+    // widget entries than 32 bit offsets can address (the grid is left empty)
+    bool build() {
+        std::vector<std::vector<uint16_t>> cells(columns*rows);
+
+        for (size_t id = 0; id < bounds.size(); id++) {
+            const Rectangle& rec = bounds[id];
+            for (int y = cellCoord(rec.y, rows); y <= cellCoord(rec.y + rec.height, rows); y++)
+                for (int x = cellCoord(rec.x, columns); x <= cellCoord(rec.x + rec.width, columns); x++)
+                    cells[y*columns + x].push_back((uint16_t)id);
+        }
+
+        size_t entries = 0;
+        for (const auto& cell : cells) entries += cell.size();
+
+        cellStart.assign(cells.size() + 1, 0);
+        cellWidgets.clear();
+        if (entries > UINT32_MAX) return false;
+
+        cellWidgets.reserve(entries);
+        for (size_t i = 0; i < cells.size(); i++) {
+            cellWidgets.insert(cellWidgets.end(), cells[i].begin(), cells[i].end());
+            cellStart[i + 1] = (uint32_t)cellWidgets.size();
+        }
+        return true;
+    }
+
+    // Returns the first registered widget containing the point, or none
+    int hitTest(Vector2 point) const {
+        if (point.x < 0 || point.y < 0 || cellStart.empty()) return none;
+
+        int cell = cellCoord(point.y, rows)*columns + cellCoord(point.x, columns);
+        for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+            const Rectangle& rec = bounds[cellWidgets[i]];
+            if (point.x >= rec.x && point.x < rec.x + rec.width &&
+                point.y >= rec.y && point.y < rec.y + rec.height) return cellWidgets[i];
+        }
+        return none;
+    }
+
+    const Rectangle& getBounds(int id) const {
+        return bounds[id];
+    }
+};
+
+#endif // WIDGET_GRID_H
@@ -0,0 +1,104 @@
+#include "work_pool.h"
+
+namespace resistor {
+
+WorkPool::WorkPool(unsigned workerCount)
+        : generation(0), stopping(false), currentTask(nullptr), remaining(0)
+{
+    if (workerCount == 0) workerCount = std::thread::hardware_concurrency();
+    if (workerCount == 0) workerCount = 1;
+
+    for (unsigned i = 0; i < workerCount; i++) queues.emplace_back(new TaskQueue());
+
+    // Worker 0 is the thread calling run()
+    for (unsigned i = 1; i < workerCount; i++) threads.emplace_back(&WorkPool::workerLoop, this, i);
+}
+
+WorkPool::~WorkPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+bool WorkPool::takeTask(unsigned worker, size_t& index)
+{
+    {
+        TaskQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            index = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (unsigned offset = 1; offset < queues.size(); offset++) {
+        TaskQueue& victim = *queues[(worker + offset)%queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            index = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkPool::work(unsigned worker)
+{
+    size_t index;
+    while (takeTask(worker, index)) {
+        (*currentTask)(index, worker);
+
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            done.notify_all();
+        }
+    }
+}
+
+void WorkPool::workerLoop(unsigned worker)
+{
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [&]{ return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        work(worker);
+    }
+}
+
+void WorkPool::run(size_t count, const Task& task)
+{
+    if (count == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        currentTask = &task;
+        remaining.store(count, std::memory_order_relaxed);
+
+        // The task pointer is published before any index can be taken
+        for (size_t i = 0; i < count; i++) {
+            TaskQueue& queue = *queues[i%queues.size()];
+            std::lock_guard<std::mutex> queueLock(queue.mutex);
+            queue.tasks.push_back(i);
+        }
+        generation++;
+    }
+    wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    done.wait(lock, [&]{ return remaining.load(std::memory_order_acquire) == 0; });
+}
+
+} // namespace resistor
@@ -0,0 +1,68 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+// Small persistent thread pool for the calculator engines (network synthesis, analysis...).
+// run() splits a job in indexed tasks dealt round-robin to per-worker queues. A worker pops
+// its own queue from the back and, once empty, steals from the front of the others, so uneven
+// tasks (pruned search branches) still keep every core busy. The calling thread is worker 0.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace resistor {
+
+class WorkPool {
+public:
+    // task(index, worker), worker is in [0, getWorkerCount())
+    using Task = std::function<void(size_t, unsigned)>;
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation;
+    bool stopping;
+
+    const Task* currentTask;
+    std::atomic<size_t> remaining;
+
+    bool takeTask(unsigned worker, size_t& index);
+    void work(unsigned worker);
+    void workerLoop(unsigned worker);
+
+public:
+    // 0 uses one worker per hardware thread
+    explicit WorkPool(unsigned workerCount = 0);
+    ~WorkPool();
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    unsigned getWorkerCount() const {
+        return (unsigned)queues.size();
+    }
+
+    // Runs task for every index in [0, count) and returns once all of them finished
+    // NOTE: Not reentrant, a task must not call run() on the same pool
+    void run(size_t count, const Task& task);
+};
+
+} // namespace resistor
+
+#endif // WORK_POOL_H
@@ -0,0 +1,383 @@
+// Streaming batch decoder for band color logs, host side.
+//
+//   band_decode [--binary] [--threads N] [input|-] [output|-]
+//
+// Every input line holds 3 to 6 comma separated band colors ("brown,black,red,gold"), decoded
+// with the band layouts of band_layout.h (3 bands is 4 bands without tolerance band, gold and
+// silver multipliers included) and checked against the E-series (e_series.h).
+// One output record per non-empty input line, in input order:
+//   CSV:    value,ohms,tolerance,tempco,series   e.g. "1k,1000,5%,,E6" or "error" for a bad line
+//   Binary: DecodeRecord (16 bytes, little endian), see below
+// Files are mapped with mmap, stdin is read in large chunks. Each window of input is split on
+// line boundaries across the worker threads, their outputs are written back in order.
+
+#include "band_layout.h"
+#include "e_series.h"
+#include "work_pool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace resistor;
+
+constexpr uint8_t InvalidColor = 0xff;
+constexpr uint8_t maxBands = 6;
+
+enum DecodeStatus : uint8_t {
+    DecodeOk,
+    DecodeNonStandard,      // Valid bands, but the value is not an E-series value
+    DecodeError             // Unknown color, wrong band count or color not allowed at its position
+};
+
+struct DecodeRecord {
+    uint64_t milliohms;
+    uint8_t status;         // DecodeStatus
+    uint8_t series;         // Smallest ESeries containing the value, 0xff if none
+    uint8_t colors[maxBands];   // Bands as read, padded with NoBand, 3 bands get a NoBand tolerance
+};
+
+static_assert(sizeof(DecodeRecord) == 16, "binary records are 16 bytes");
+
+//----------------------------------------------------------------------------------
+// Color parsing, perfect hash on (first letter, third letter, length)
+//----------------------------------------------------------------------------------
+struct ColorName {
+    const char* name;
+    uint8_t length;
+    uint8_t color;
+};
+
+constexpr ColorName colorNames[] = {
+    { "black", 5, Black }, { "brown", 5, Brown }, { "red", 3, Red }, { "orange", 6, Orange },
+    { "yellow", 6, Yellow }, { "green", 5, Green }, { "blue", 4, Blue }, { "violet", 6, Violet },
+    { "gray", 4, Gray }, { "grey", 4, Gray }, { "white", 5, White }, { "gold", 4, Gold },
+    { "silver", 6, Silver }, { "none", 4, NoBand }
+};
+
+constexpr uint8_t colorHashSize = 32;
+
+// Names are at least 3 letters, lowercased by setting bit 5
+constexpr uint8_t colorHash(const char* text, size_t length)
+{
+    return (uint8_t)(((uint8_t)(text[0] | 0x20) + 3*(uint8_t)(text[2] | 0x20) + length)%colorHashSize);
+}
+
+constexpr std::array<int8_t, colorHashSize> makeColorSlots()
+{
+    std::array<int8_t, colorHashSize> slots = {};
+    for (uint8_t i = 0; i < colorHashSize; i++) slots[i] = -1;
+    for (uint8_t i = 0; i < sizeof(colorNames)/sizeof(colorNames[0]); i++)
+        slots[colorHash(colorNames[i].name, colorNames[i].length)] = (int8_t)i;
+    return slots;
+}
+
+constexpr std::array<int8_t, colorHashSize> colorSlots = makeColorSlots();
+
+constexpr bool colorHashIsPerfect()
+{
+    for (uint8_t i = 0; i < sizeof(colorNames)/sizeof(colorNames[0]); i++)
+        if (colorSlots[colorHash(colorNames[i].name, colorNames[i].length)] != (int8_t)i) return false;
+    return true;
+}
+
+static_assert(colorHashIsPerfect(), "color names must not collide");
+
+static uint8_t parseColor(const char* text, size_t length)
+{
+    if (length < 3 || length > 6) return InvalidColor;
+
+    int8_t slot = colorSlots[colorHash(text, length)];
+    if (slot < 0 || colorNames[slot].length != length) return InvalidColor;
+
+    // The hash only looked at two letters, confirm the whole name
+    const char* name = colorNames[slot].name;
+    for (size_t i = 0; i < length; i++) if ((char)(text[i] | 0x20) != name[i]) return InvalidColor;
+    return colorNames[slot].color;
+}
+
+//----------------------------------------------------------------------------------
+// Decoding
+//----------------------------------------------------------------------------------
+static DecodeRecord decodeLine(const char* line, const char* end)
+{
+    DecodeRecord record = {};
+    record.status = DecodeError;
+    record.series = 0xff;
+    for (uint8_t i = 0; i < maxBands; i++) record.colors[i] = NoBand;
+
+    uint8_t count = 0;
+
+    const char* p = line;
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        const char* start = p;
+        while (p < end && *p != ',') p++;
+        const char* stop = p;
+        while (stop > start && (stop[-1] == ' ' || stop[-1] == '\t' || stop[-1] == '\r')) stop--;
+        if (p < end) p++;   // Skip the comma
+
+        if (count == maxBands) return record;
+        record.colors[count++] = parseColor(start, (size_t)(stop - start));
+    }
+
+    if (count < 3) return record;
+
+    // Without tolerance band, record.colors[3] is already NoBand
+    uint8_t bandCount = (count == 3) ? 4 : count;
+    BandDecode decoded = decodeBands(record.colors, bandCount);
+    if (!decoded.valid) return record;
+
+    uint8_t digitCount = (bandCount == 4) ? 2 : 3;
+    uint16_t significand = 0;
+    for (uint8_t i = 0; i < digitCount; i++) significand = (uint16_t)(significand*10 + record.colors[i]);
+
+    uint8_t series = smallestSeries(significand, digitCount);
+    record.milliohms = decoded.milliohms;
+    record.series = (series < SeriesCount) ? series : 0xff;
+    record.status = (series < SeriesCount) ? DecodeOk : DecodeNonStandard;
+    return record;
+}
+
+// Longest CSV record: "999B,999000000000,0.25%,250,none\n"
+constexpr size_t maxRecordSize = 64;
+
+static char* writeText(char* out, const char* text)
+{
+    while (*text != '\0') *out++ = *text++;
+    return out;
+}
+
+// Writes at most maxRecordSize bytes, returns the end of the record
+static char* writeRecordCsv(char* out, const DecodeRecord& record)
+{
+    static const char* seriesNames[SeriesCount] = { "E6", "E12", "E24", "E48", "E96", "E192" };
+
+    if (record.status == DecodeError) return writeText(out, "error\n");
+
+    out += formatMilliohms(record.milliohms, out);
+    *out++ = ',';
+
+    // Gold and silver multipliers leave at most two decimals
+    out += appendNumber(out, 0, record.milliohms/1000);
+    uint64_t centiohms = (record.milliohms%1000)/10;
+    if (centiohms != 0) {
+        *out++ = '.';
+        *out++ = (char)('0' + centiohms/10);
+        if (centiohms%10 != 0) *out++ = (char)('0' + centiohms%10);
+    }
+    *out++ = ',';
+
+    // Band positions follow the layout, see decodeLine()
+    uint8_t bandCount = (record.colors[4] != NoBand) ? ((record.colors[5] != NoBand) ? 6 : 5) : 4;
+    uint8_t toleranceBand = (bandCount == 4) ? 3 : 4;
+    out += formatPercent(standardTolerance[record.colors[toleranceBand]], out);
+    *out++ = ',';
+    if (bandCount == 6) out += appendNumber(out, 0, standardTempco[record.colors[5]]);
+    *out++ = ',';
+
+    out = writeText(out, (record.series < SeriesCount) ? seriesNames[record.series] : "none");
+    *out++ = '\n';
+    return out;
+}
+
+//----------------------------------------------------------------------------------
+// Input windows and parallel processing
+//----------------------------------------------------------------------------------
+constexpr size_t windowSize = 64u << 20;        // Bytes processed between two writes
+constexpr size_t minSliceSize = 1u << 20;       // Smaller windows are not worth splitting further
+
+struct Options {
+    bool binary;
+    unsigned threads;
+    const char* input;
+    const char* output;
+};
+
+static void processSlice(const char* begin, const char* end, bool binary, std::vector<char>& out)
+{
+    size_t used = 0;
+    out.resize((size_t)(end - begin) + maxRecordSize);
+
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = (const char*)memchr(line, '\n', (size_t)(end - line));
+        const char* stop = (newline != nullptr) ? newline : end;
+
+        if (stop > line) {
+            if (used + maxRecordSize > out.size()) out.resize(out.size()*2);
+
+            DecodeRecord record = decodeLine(line, stop);
+            if (binary) {
+                memcpy(out.data() + used, &record, sizeof(record));
+                used += sizeof(record);
+            }
+            else {
+                used = (size_t)(writeRecordCsv(out.data() + used, record) - out.data());
+            }
+        }
+        line = stop + 1;
+    }
+
+    out.resize(used);
+}
+
+// Decodes whole lines of [begin, end) on every worker and writes the results in order
+static bool processWindow(WorkPool& pool, const char* begin, const char* end, bool binary,
+                          std::vector<std::vector<char>>& outputs, FILE* output)
+{
+    size_t size = (size_t)(end - begin);
+    size_t sliceCount = std::max<size_t>(1, std::min<size_t>(outputs.size(), size/minSliceSize));
+
+    // Slice bounds are moved forward to the next line start
+    std::vector<const char*> bounds(sliceCount + 1, end);
+    bounds[0] = begin;
+    for (size_t i = 1; i < sliceCount; i++) {
+        const char* guess = std::max(begin + size*i/sliceCount, bounds[i - 1]);
+        const char* newline = (const char*)memchr(guess, '\n', (size_t)(end - guess));
+        bounds[i] = (newline != nullptr) ? newline + 1 : end;
+    }
+
+    pool.run(sliceCount, [&](size_t slice, unsigned) {
+        processSlice(bounds[slice], bounds[slice + 1], binary, outputs[slice]);
+    });
+
+    for (size_t i = 0; i < sliceCount; i++)
+        if (fwrite(outputs[i].data(), 1, outputs[i].size(), output) != outputs[i].size()) return false;
+    return true;
+}
+
+static bool processMapped(WorkPool& pool, int fd, size_t size, bool binary,
+                          std::vector<std::vector<char>>& outputs, FILE* output)
+{
+    if (size == 0) return true;
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) return false;
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    const char* data = (const char*)mapping;
+    const char* end = data + size;
+    bool ok = true;
+
+    for (const char* window = data; ok && window < end;) {
+        const char* stop = (end - window > (ptrdiff_t)windowSize) ? window + windowSize : end;
+        if (stop < end) {
+            const char* newline = (const char*)memchr(stop, '\n', (size_t)(end - stop));
+            stop = (newline != nullptr) ? newline + 1 : end;
+        }
+        ok = processWindow(pool, window, stop, binary, outputs, output);
+        window = stop;
+    }
+
+    munmap(mapping, size);
+    return ok;
+}
+
+// Pipes and stdin: large reads, the partial last line is carried over to the next window
+static bool processStream(WorkPool& pool, FILE* input, bool binary,
+                          std::vector<std::vector<char>>& outputs, FILE* output)
+{
+    std::vector<char> buffer(windowSize);
+    size_t carried = 0;
+
+    for (;;) {
+        size_t read = fread(buffer.data() + carried, 1, buffer.size() - carried, input);
+        size_t filled = carried + read;
+        bool last = (read == 0);
+        if (filled == 0) return true;
+
+        const char* begin = buffer.data();
+        const char* stop = begin + filled;
+        if (!last) {
+            const char* newline = begin + filled;
+            while (newline > begin && newline[-1] != '\n') newline--;
+            if (newline == begin) {
+                // A single line longer than the buffer, grow it
+                buffer.resize(buffer.size()*2);
+                carried = filled;
+                continue;
+            }
+            stop = newline;
+        }
+
+        if (!processWindow(pool, begin, stop, binary, outputs, output)) return false;
+        if (last) return true;
+
+        carried = (size_t)(begin + filled - stop);
+        memmove(buffer.data(), stop, carried);
+    }
+}
+
+static bool parseOptions(int argc, char** argv, Options& options)
+{
+    options = { false, 0, "-", "-" };
+    int positional = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--binary") == 0) options.binary = true;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) options.threads = (unsigned)atoi(argv[++i]);
+        else if (argv[i][0] == '-' && argv[i][1] == '-') return false;
+        else if (positional == 0) { options.input = argv[i]; positional++; }
+        else if (positional == 1) { options.output = argv[i]; positional++; }
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: band_decode [--binary] [--threads N] [input|-] [output|-]\n");
+        return 2;
+    }
+
+    FILE* output = (strcmp(options.output, "-") == 0) ? stdout : fopen(options.output, "wb");
+    if (output == nullptr) {
+        fprintf(stderr, "band_decode: cannot open output '%s'\n", options.output);
+        return 1;
+    }
+    setvbuf(output, nullptr, _IOFBF, 1u << 20);
+
+    WorkPool pool(options.threads);
+    std::vector<std::vector<char>> outputs(pool.getWorkerCount()*4);    // A few slices per worker for balance
+
+    bool ok = true;
+    if (strcmp(options.input, "-") == 0) {
+        ok = processStream(pool, stdin, options.binary, outputs, output);
+    }
+    else {
+        int fd = open(options.input, O_RDONLY);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            fprintf(stderr, "band_decode: cannot open input '%s'\n", options.input);
+            if (fd >= 0) close(fd);
+            return 1;
+        }
+
+        // Pipes and devices are streamed through a FILE that owns the descriptor from then on
+        FILE* input = S_ISREG(info.st_mode) ? nullptr : fdopen(fd, "rb");
+        if (S_ISREG(info.st_mode)) ok = processMapped(pool, fd, (size_t)info.st_size, options.binary, outputs, output);
+        else ok = (input != nullptr) && processStream(pool, input, options.binary, outputs, output);
+
+        if (input != nullptr) fclose(input);
+        else close(fd);
+    }
+
+    if (fflush(output) != 0) ok = false;
+    if (output != stdout) fclose(output);
+
+    if (!ok) {
+        fprintf(stderr, "band_decode: failed while processing '%s'\n", options.input);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Host test of the band_decode CLI. A fixture log (every band layout, gold and silver multipliers,
+// case, spaces and CRLF, blank and bad lines, no final newline) goes through the mmap path (a file),
+// the stream path (stdin as "-") and the fdopen path (a pipe opened by name, /dev/stdin), with 1,
+// 2, 4 and 8 threads, and every output must be the expected CSV. Then a log of repeated fixture
+// lines is timed through the file and stdin paths, next to a memcpy of the same bytes.
+//
+//   band_decode_test path/to/band_decode [megabytes]
+//
+// Default 64 MB for the timed log. Files are written to the working directory.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const char fixture[] =
+    "brown,black,red,gold\n"
+    "yellow,violet,orange\n"
+    "red,red,black,black,brown\n"
+    "orange,white,gray,yellow,brown,red\n"
+    "green,blue,gold,gold\n"
+    "brown,black,silver,silver\n"
+    " Brown , BLACK ,Orange,Silver\r\n"
+    "\n"
+    "grey,red,brown,none\n"
+    "purple,black,red\n"
+    "brown,black\n"
+    "brown,black,red,gold,red,red,red\n"
+    "gold,black,red,gold\n"
+    "white,white,white,white\n"
+    "blue,gray,green,brown,violet,black\n"
+    "brown,black,black,orange,gold";
+
+static const char expected[] =
+    "1k,1000,5%,,E6\n"
+    "47k,47000,20%,,E6\n"
+    "220,220,1%,,E6\n"
+    "3.98M,3980000,1%,50,none\n"
+    "5.60,5.6,5%,,E12\n"
+    "0.10,0.1,10%,,E6\n"
+    "10k,10000,10%,,E6\n"
+    "820,820,20%,,E12\n"
+    "error\n"
+    "error\n"
+    "error\n"
+    "error\n"
+    "error\n"
+    "6.85k,6850,0.1%,250,none\n"
+    "100k,100000,5%,,E6\n";
+
+static const char* inputFile = "band_decode_test.in";
+static const char* outputFile = "band_decode_test.out";
+
+static bool writeFile(const char* fileName, const std::string& data)
+{
+    FILE* file = fopen(fileName, "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return (fclose(file) == 0) && ok;
+}
+
+static std::string readFile(const char* fileName)
+{
+    std::string data;
+    FILE* file = fopen(fileName, "rb");
+    if (file == nullptr) return data;
+    char buffer[1 << 16];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) data.append(buffer, read);
+    fclose(file);
+    return data;
+}
+
+// Runs band_decode on inputFile, or with data written to its stdin when input is "-" or "/dev/stdin"
+static bool runDecoder(const char* decoder, unsigned threads, const char* input, const std::string& data)
+{
+    char command[1024];
+    snprintf(command, sizeof(command), "'%s' --threads %u '%s' '%s'", decoder, threads, input, outputFile);
+    if (strcmp(input, inputFile) == 0) return system(command) == 0;
+
+    FILE* pipe = popen(command, "w");
+    if (pipe == nullptr) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), pipe) == data.size();
+    return (pclose(pipe) == 0) && ok;
+}
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: band_decode_test path/to/band_decode [megabytes]\n");
+        return 2;
+    }
+    const char* decoder = argv[1];
+    size_t megabytes = (argc > 2) ? (size_t)atol(argv[2]) : 64;
+
+    const char* inputs[3] = { inputFile, "-", "/dev/stdin" };
+    const char* paths[3] = { "mmap", "stream", "fdopen" };
+
+    if (!writeFile(inputFile, fixture)) {
+        fprintf(stderr, "band_decode_test: cannot write '%s'\n", inputFile);
+        return 1;
+    }
+    for (int path = 0; path < 3; path++) {
+        for (unsigned threads : { 1, 2, 4, 8 }) {
+            if (!runDecoder(decoder, threads, inputs[path], fixture) || readFile(outputFile) != expected) {
+                fprintf(stderr, "band_decode_test: %s path, %u threads: output differs from the expected CSV\n", paths[path], threads);
+                return 1;
+            }
+        }
+        printf("check   %-7s path, 1 to 8 threads: same as the expected CSV\n", paths[path]);
+    }
+
+    // Repeated fixture lines, slices and windows then span many lines
+    std::string line = std::string(fixture) + "\n";
+    std::string log, logExpected;
+    size_t repeats = (megabytes << 20)/line.size() + 1;
+    log.reserve(repeats*line.size());
+    logExpected.reserve(repeats*sizeof(expected));
+    for (size_t i = 0; i < repeats; i++) {
+        log += line;
+        logExpected += expected;
+    }
+    size_t lines = repeats*15;
+
+    if (!writeFile(inputFile, log)) {
+        fprintf(stderr, "band_decode_test: cannot write '%s'\n", inputFile);
+        return 1;
+    }
+
+    std::vector<char> copy(log.size());
+    double copyTime = 1e30;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        memcpy(copy.data(), log.data(), log.size());
+        copyTime = std::min(copyTime, elapsedSeconds(start));
+    }
+    double megabyteCount = log.size()/1048576.0;
+
+    bool ok = true;
+    for (int path = 0; path < 2; path++) {
+        auto start = std::chrono::steady_clock::now();
+        bool ran = runDecoder(decoder, 0, inputs[path], log);
+        double time = elapsedSeconds(start);
+        bool same = ran && readFile(outputFile) == logExpected;
+
+        printf("decode  %-7s path, %.0f MB, %zu lines: %6.1f MB/s, %5.1f M lines/s (memcpy %.0f MB/s): %s\n", paths[path],
+               megabyteCount, lines, megabyteCount/time, lines/time/1e6, megabyteCount/copyTime, same ? "ok" : "MISMATCH");
+        ok &= same;
+    }
+
+    remove(inputFile);
+    remove(outputFile);
+    return ok ? 0 : 1;
+}
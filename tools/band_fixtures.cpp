@@ -0,0 +1,116 @@
+// Synthetic photo fixtures for tools/band_recognize, host side. Each fixture is a resistor drawn
+// on a plain background: leads, a shaded body and its bands in the calculator palette (gold and
+// silver as they usually photograph), rotated and with per-pixel noise, saved as JPG or PNG.
+//
+//   band_fixtures output_dir
+//
+// Writes the files listed in fixtures[] below, and prints one "file=colors" argument per fixture
+// for band_recognize. Rendering is seeded, so the files are the same on every run.
+
+#include "band_recognition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+using namespace resistor;
+
+struct Fixture {
+    const char* fileName;
+    const char* colors;                 // band_recognize names, "none" when nothing is recognized
+    int width, height;
+    RgbColor background, body;
+    std::vector<uint8_t> bands;
+    float angle;                        // Radians
+};
+
+static const std::vector<Fixture> fixtures = {
+    { "4band_12mp.jpg", "yellow,violet,red,gold", 4000, 3000, { 245, 245, 240 }, { 210, 180, 140 }, { Yellow, Violet, Red, Gold }, 0.3f },
+    { "5band.png", "brown,black,black,red,brown", 1600, 1200, { 120, 90, 60 }, { 60, 120, 200 }, { Brown, Black, Black, Red, Brown }, 2.0f },
+    { "3band.png", "red,red,orange", 1000, 750, { 40, 40, 40 }, { 210, 180, 140 }, { Red, Red, Orange }, 1.1f },
+    { "4band_silver.jpg", "green,blue,brown,silver", 1200, 900, { 40, 40, 40 }, { 200, 170, 120 }, { Green, Blue, Brown, Silver }, 0.0f },
+    { "6band.png", "orange,white,gray,yellow,brown,red", 1000, 750, { 245, 245, 240 }, { 60, 120, 200 }, { Orange, White, Gray, Yellow, Brown, Red }, 2.6f },
+    { "portrait.jpg", "brown,black,green,gold", 750, 1000, { 120, 90, 60 }, { 200, 170, 120 }, { Brown, Black, Green, Gold }, 1.57f },
+    // Reduces to a pyramid level less than one row high
+    { "strip.png", "none", 16384, 16, { 245, 245, 240 }, { 210, 180, 140 }, { Yellow, Violet, Red, Gold }, 0.0f },
+};
+
+static RgbColor bandColor(uint8_t color)
+{
+    if (color < ColorCount) return buttonPalette[color];
+    return (color == Gold) ? goldBand : silverBand;
+}
+
+static std::vector<uint8_t> render(const Fixture& fixture, std::mt19937& random)
+{
+    int width = fixture.width, height = fixture.height;
+    std::vector<uint8_t> pixels((size_t)width*height*4);
+
+    // Resistor centered, body half as long as the leads, sized on the shorter side for portraits
+    float centerX = width/2.0f, centerY = height/2.0f;
+    float length = std::max(width, height)*0.45f;
+    float thickness = std::min(width, height)*0.12f;
+    float dirX = std::cos(fixture.angle), dirY = std::sin(fixture.angle);
+    size_t bandCount = fixture.bands.size();
+    std::uniform_int_distribution<int> noise(-8, 8);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float px = x - centerX, py = y - centerY;
+            float along = px*dirX + py*dirY, across = -px*dirY + py*dirX;
+            RgbColor color = fixture.background;
+
+            if (std::fabs(across) < thickness*0.08f && std::fabs(along) < length*0.9f) color = (RgbColor){ 150, 150, 155 };
+            if (std::fabs(along) < length*0.5f && std::fabs(across) < thickness*0.5f) {
+                color = fixture.body;
+
+                // Digit bands from the left end, the last band near the right end
+                float position = (along + length*0.5f)/length;
+                for (size_t band = 0; band < bandCount; band++) {
+                    float center = (band < bandCount - 1) ? 0.15f + 0.1f*band : 0.85f;
+                    if (std::fabs(position - center) < 0.035f) color = bandColor(fixture.bands[band]);
+                }
+
+                float edge = across/(thickness*0.5f);
+                float shade = 1.0f - 0.3f*edge*edge;
+                color = (RgbColor){ (uint8_t)(color.r*shade), (uint8_t)(color.g*shade), (uint8_t)(color.b*shade) };
+            }
+
+            uint8_t* pixel = &pixels[((size_t)y*width + x)*4];
+            const uint8_t channels[3] = { color.r, color.g, color.b };
+            for (int c = 0; c < 3; c++) pixel[c] = (uint8_t)std::min(255, std::max(0, channels[c] + noise(random)));
+            pixel[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: band_fixtures output_dir\n");
+        return 2;
+    }
+
+    std::mt19937 random(3);
+    for (const Fixture& fixture : fixtures) {
+        std::vector<uint8_t> pixels = render(fixture, random);
+        std::string path = std::string(argv[1]) + "/" + fixture.fileName;
+        bool jpg = (path.compare(path.size() - 4, 4, ".jpg") == 0);
+
+        int written = jpg ? stbi_write_jpg(path.c_str(), fixture.width, fixture.height, 4, pixels.data(), 90)
+                          : stbi_write_png(path.c_str(), fixture.width, fixture.height, 4, pixels.data(), fixture.width*4);
+        if (written == 0) {
+            fprintf(stderr, "band_fixtures: cannot write '%s'\n", path.c_str());
+            return 1;
+        }
+        printf("%s=%s\n", path.c_str(), fixture.colors);
+    }
+    return 0;
+}
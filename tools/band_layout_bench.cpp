@@ -0,0 +1,132 @@
+// Batch decode benchmark of the band layouts (band_layout.h), host side. For every layout (4, 5 and
+// 6 bands) random rows of colors, gold/silver/missing bands and out of range colors included, are
+// decoded with decodeBandsBatch() and with a branching decoder written from the IEC 60062 rules.
+// Both must agree on every row, then both are timed.
+//
+//   band_layout_bench [rows]
+//
+// Default 10 million rows per layout. Exits non-zero on the first mismatch.
+
+#include "band_layout.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace resistor;
+
+// Plain per-band decoding with a switch per band, the tables are not used
+static BandDecode branchingDecode(const uint8_t* colors, uint8_t bandCount)
+{
+    uint8_t digitCount = (bandCount == 4) ? 2 : 3;
+    BandDecode result = {};
+
+    uint64_t significand = 0;
+    for (uint8_t i = 0; i < digitCount; i++) {
+        if (colors[i] >= ColorCount) return result;
+        significand = significand*10 + colors[i];
+    }
+
+    uint8_t multiplier = colors[digitCount];
+    if (multiplier < ColorCount) result.milliohms = significand*powerOf10(multiplier)*1000;
+    else if (multiplier == Gold) result.milliohms = significand*100;
+    else if (multiplier == Silver) result.milliohms = significand*10;
+    else return result;
+
+    // Out of range colors read as a missing band, as documented in band_layout.h
+    uint8_t tolerance = (colors[digitCount + 1] < ExtendedColorCount) ? colors[digitCount + 1] : (uint8_t)NoBand;
+    switch (tolerance) {
+        case Brown: result.tolerance = 100; break;
+        case Red: result.tolerance = 200; break;
+        case Green: result.tolerance = 50; break;
+        case Blue: result.tolerance = 25; break;
+        case Violet: result.tolerance = 10; break;
+        case Gray: result.tolerance = 5; break;
+        case Gold: result.tolerance = 500; break;
+        case Silver: result.tolerance = 1000; break;
+        case NoBand: if (bandCount == 4) { result.tolerance = 2000; break; } return result;
+        default: return result;
+    }
+
+    if (bandCount == 6) {
+        switch (colors[5]) {
+            case Black: result.tempco = 250; break;
+            case Brown: result.tempco = 100; break;
+            case Red: result.tempco = 50; break;
+            case Orange: result.tempco = 15; break;
+            case Yellow: result.tempco = 25; break;
+            case Green: result.tempco = 20; break;
+            case Blue: result.tempco = 10; break;
+            case Violet: result.tempco = 5; break;
+            case Gray: result.tempco = 1; break;
+            default: return result;
+        }
+    }
+
+    result.valid = true;
+    return result;
+}
+
+static bool sameDecode(const BandDecode& a, const BandDecode& b)
+{
+    if (a.valid != b.valid) return false;
+    return !a.valid || (a.milliohms == b.milliohms && a.tolerance == b.tolerance && a.tempco == b.tempco);
+}
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool benchmarkLayout(uint8_t bandCount, size_t rows, std::mt19937& random)
+{
+    // One color past ExtendedColorCount stands for any out of range value
+    std::vector<uint8_t> colors(rows*bandCount);
+    for (uint8_t& color : colors) color = (uint8_t)(random() % (ExtendedColorCount + 1));
+
+    std::vector<BandDecode> results(rows), expected(rows);
+    size_t valid = 0;
+    decodeBandsBatch(colors.data(), bandCount, results.data(), rows);
+    for (size_t i = 0; i < rows; i++) {
+        expected[i] = branchingDecode(&colors[i*bandCount], bandCount);
+        if (!sameDecode(results[i], expected[i])) {
+            fprintf(stderr, "band_layout_bench: %u bands, row %zu: tables and branching decoder differ\n", bandCount, i);
+            return false;
+        }
+        valid += expected[i].valid;
+    }
+
+    // Best of 3 runs each
+    double tables = 1e30, branching = 1e30;
+    uint64_t sum = 0;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        decodeBandsBatch(colors.data(), bandCount, results.data(), rows);
+        tables = std::min(tables, elapsedSeconds(start));
+        sum += results[rows - 1].milliohms;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rows; i++) expected[i] = branchingDecode(&colors[i*bandCount], bandCount);
+        branching = std::min(branching, elapsedSeconds(start));
+        sum += expected[rows - 1].milliohms;
+    }
+
+    printf("decode  %u bands, %zu rows (%.1f%% valid): tables %7.1f M rows/s, branching %7.1f M rows/s  (%llu)\n",
+           bandCount, rows, 100.0*valid/rows, rows/tables/1e6, rows/branching/1e6, (unsigned long long)sum);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    size_t rows = (argc > 1) ? (size_t)atol(argv[1]) : 10000000;
+    if (rows == 0) rows = 1;
+    std::mt19937 random(1);
+
+    for (uint8_t bandCount : { 4, 5, 6 }) {
+        if (!benchmarkLayout(bandCount, rows, random)) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Band recognition on photo files, host side. Runs the same recognizer as the app
+// (band_recognition.h) on fixture images, with the photo decoded by stb_image like LoadImage.
+//
+//   band_recognize image[=colors] ...
+//
+// Prints one line per image: recognized colors, decoded value and the recognition time.
+// With "=brown,black,red,gold" after the file name the colors are also checked, the exit status
+// is 1 when any image does not match.
+
+#include "band_recognition.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+using namespace resistor;
+
+constexpr const char* colorNames[NoBand] = {
+    "black", "brown", "red", "orange", "yellow", "green", "blue", "violet", "gray", "white",
+    "gold", "silver"
+};
+
+static std::string describeColors(const RecognizedBands& bands)
+{
+    std::string text;
+    uint8_t count = (bands.count <= maxRecognizedBands) ? bands.count : 0;
+    if (count < 3) return "none";
+
+    for (uint8_t band = 0; band < count; band++) {
+        if (band > 0) text += ',';
+        text += colorNames[bands.colors[band]];
+    }
+    return text;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: band_recognize image[=colors] ...\n");
+        return 2;
+    }
+
+    BandRecognizer recognizer;
+    bool allMatch = true;
+
+    for (int arg = 1; arg < argc; arg++) {
+        std::string fileName = argv[arg];
+        std::string expected;
+        size_t separator = fileName.rfind('=');
+        if (separator != std::string::npos) {
+            expected = fileName.substr(separator + 1);
+            fileName.resize(separator);
+        }
+
+        int width = 0, height = 0, channels = 0;
+        unsigned char* pixels = stbi_load(fileName.c_str(), &width, &height, &channels, 4);
+        if (pixels == nullptr) {
+            fprintf(stderr, "band_recognize: cannot load '%s'\n", fileName.c_str());
+            allMatch = false;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        RecognizedBands bands = recognizer.recognize(pixels, width, height, width*4);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stbi_image_free(pixels);
+
+        std::string colors = describeColors(bands);
+        char value[16] = "-";
+        char tolerance[8] = "-";
+        if (bands.decode.valid) {
+            formatMilliohms(bands.decode.milliohms, value);
+            formatPercent(bands.decode.tolerance, tolerance);
+        }
+
+        bool match = expected.empty() || expected == colors;
+        allMatch &= match;
+        printf("%s: %s %s %s %dx%d %.1f ms%s\n", fileName.c_str(), colors.c_str(), value, tolerance,
+               width, height, milliseconds, match ? "" : (" MISMATCH, expected " + expected).c_str());
+    }
+
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// Host test of the band decode table (resistor_decode.h) against the formula drawResistor() used
+// before the table: every digit/digit/multiplier combination and every tolerance band must give
+// the same value and text. Then times random decodes through both.
+//
+//   decode_test [decodes]
+//
+// Default 10 million decodes. Exits non-zero on the first mismatch.
+
+#include "resistor_decode.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace resistor;
+
+// drawResistor() before the decode table, kept as it was apart from returning the results
+static std::string formulaValue(uint8_t first, uint8_t second, uint8_t multiplierBand, uint64_t& ohms)
+{
+    std::string firstDigit = std::to_string(first);
+    std::string secondDigit = std::to_string(second);
+    uint8_t base = std::stoi(firstDigit + secondDigit);
+    auto multiplier = (uint64_t)std::pow(10, multiplierBand);
+    uint64_t result = base * multiplier;
+    ohms = result;
+
+    if (result < 1000) return std::to_string(result);
+
+    const std::array<std::string, 5> suffixes = { "", "k", "M", "B", "T" };
+    uint8_t suffixIndex = 0;
+    auto num = (double)result;
+
+    while (num >= 1000 && suffixIndex < 4) {
+        num /= 1000;
+        suffixIndex++;
+    }
+
+    if (num == std::floor(num)) return std::to_string((int)num) + suffixes[suffixIndex];
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << num;
+    return out.str() + suffixes[suffixIndex];
+}
+
+// Tolerance band rule of drawResistor() before the table, ColorCount for an unset band
+static const char* formulaTolerance(uint8_t color)
+{
+    if (color == White) return "10%";
+    if (color == Yellow) return "5%";
+    if (color == ColorCount) return "25%";
+    return "NaN";
+}
+
+static double elapsedNanoseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    size_t decodes = (argc > 1) ? (size_t)atol(argv[1]) : 10000000;
+    int mismatches = 0;
+
+    for (uint8_t first = 0; first < ColorCount; first++) {
+        for (uint8_t second = 0; second < ColorCount; second++) {
+            for (uint8_t multiplier = 0; multiplier < ColorCount; multiplier++) {
+                uint64_t ohms = 0;
+                std::string expected = formulaValue(first, second, multiplier, ohms);
+                const DecodeEntry& entry = decode(first, second, multiplier);
+                if (entry.ohms != ohms || expected != entry.text) {
+                    fprintf(stderr, "decode_test: bands %u %u %u: table %llu \"%s\", formula %llu \"%s\"\n", first, second,
+                            multiplier, (unsigned long long)entry.ohms, entry.text, (unsigned long long)ohms, expected.c_str());
+                    mismatches++;
+                }
+            }
+        }
+    }
+
+    for (uint8_t color = 0; color <= ColorCount; color++) {
+        if (strcmp(formatTolerance(color), formulaTolerance(color)) != 0) {
+            fprintf(stderr, "decode_test: tolerance band %u: table \"%s\", formula \"%s\"\n", color, formatTolerance(color), formulaTolerance(color));
+            mismatches++;
+        }
+    }
+
+    printf("check   %d values, %d tolerance bands: %s\n", decodeTableSize, ColorCount + 1, (mismatches == 0) ? "same as the formula" : "MISMATCH");
+    if (mismatches > 0) return 1;
+
+    // Random band sets, decoded through the table and through the formula (100x fewer, it allocates)
+    std::mt19937 random(1);
+    std::vector<uint16_t> bands(decodes);
+    for (uint16_t& band : bands) band = (uint16_t)(random() % decodeTableSize);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t length = 0;
+    for (uint16_t band : bands) length += strlen(formatValue(band/100, band/10%10, band%10));
+    double table = elapsedNanoseconds(start)/(double)decodes;
+
+    size_t formulaDecodes = decodes/100 + 1;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < formulaDecodes; i++) {
+        uint64_t ohms;
+        length += formulaValue(bands[i]/100, bands[i]/10%10, bands[i]%10, ohms).size();
+    }
+    double formula = elapsedNanoseconds(start)/(double)formulaDecodes;
+
+    printf("decode  %zu values: table %.2f ns, formula %.1f ns each (%zu characters)\n", decodes, table, formula, length);
+    return 0;
+}
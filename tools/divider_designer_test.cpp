@@ -0,0 +1,110 @@
+// Host test of the voltage divider designer (divider_designer.h) over E192 on 7 multiplier bands
+// (1344 values). For ratios from 0.001 to 0.99, unloaded and with a load, the best divider must
+// have the error of a brute force over every top/bottom pair, and with a trim the error of a brute
+// force over every trim of the top value below the requirement. Every query is timed and must
+// stay under a quarter of a 60 Hz frame.
+//
+//   divider_designer_test
+//
+// Exits non-zero on the first mismatch or slow query.
+
+#include "divider_designer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace resistor;
+
+constexpr double frameBudget = 1000.0/60.0/4.0;     // ms
+
+static double ratioOf(double top, double bottom, double load)
+{
+    double lower = (load > 0.0) ? bottom*load/(bottom + load) : bottom;
+    return lower/(top + lower);
+}
+
+// Smallest |error| over every top/bottom pair, and with a trim: the top leg is the largest
+// value below the requirement plus any value (the designer's trim rule)
+static double bruteForceError(const std::vector<double>& values, const DividerSpec& spec)
+{
+    double best = INFINITY;
+    for (double bottom : values) {
+        for (double top : values) best = std::min(best, std::fabs(ratioOf(top, bottom, spec.load) - spec.ratio)/spec.ratio);
+        if (!spec.trim) continue;
+
+        double lower = (spec.load > 0.0) ? bottom*spec.load/(bottom + spec.load) : bottom;
+        double required = (1.0 - spec.ratio)/spec.ratio*lower;
+        double below = 0.0;
+        for (double top : values) if (top < required) below = top;
+        if (below == 0.0) continue;
+
+        for (double trim : values) best = std::min(best, std::fabs(ratioOf(below + trim, bottom, spec.load) - spec.ratio)/spec.ratio);
+    }
+    return best;
+}
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    const DividerDesigner designer(E192, 0, 6);
+    std::vector<double> values = seriesValues(E192, 0, 6);
+
+    const double ratios[] = { 0.001, 0.01, 0.1, 1.0/3.0, 0.5, 3.3/5.0, 0.9, 0.99 };
+    const double loads[] = { 0.0, 10000.0, 1000000.0 };
+    size_t queries = 0;
+    double slowest = 0.0, total = 0.0;
+
+    for (bool trim : { false, true }) {
+        for (double load : loads) {
+            for (double ratio : ratios) {
+                DividerSpec spec = { ratio, load, trim };
+
+                // Best of 3 runs
+                DividerResult result;
+                double time = 1e30;
+                for (int run = 0; run < 3; run++) {
+                    auto start = std::chrono::steady_clock::now();
+                    result = designer.design(spec, 10);
+                    time = std::min(time, elapsedMilliseconds(start));
+                }
+                slowest = std::max(slowest, time);
+                total += time;
+                queries++;
+
+                if (result.byError.empty()) {
+                    fprintf(stderr, "divider_designer_test: ratio %g, load %g, trim %d: no divider\n", ratio, load, trim);
+                    return 1;
+                }
+
+                double expected = bruteForceError(values, spec);
+                const Divider& best = result.byError.front();
+                double upper = (double)best.top.ohms + (double)best.trim.ohms;
+                bool consistent = (std::fabs(ratioOf(upper, (double)best.bottom.ohms, load) - best.ratio) <= 1e-12) &&
+                                  (trim || best.trim.ohms == 0);
+
+                if (!consistent || std::fabs(std::fabs(best.error) - expected) > 1e-12*expected + 1e-15) {
+                    fprintf(stderr, "divider_designer_test: ratio %g, load %g, trim %d: best error %.9g (%llu + %llu over %llu), brute force %.9g\n",
+                            ratio, load, trim, std::fabs(best.error), (unsigned long long)best.top.ohms,
+                            (unsigned long long)best.trim.ohms, (unsigned long long)best.bottom.ohms, expected);
+                    return 1;
+                }
+                if (time > frameBudget) {
+                    fprintf(stderr, "divider_designer_test: ratio %g, load %g, trim %d: %.2f ms, over %.2f ms\n", ratio, load, trim, time, frameBudget);
+                    return 1;
+                }
+            }
+        }
+        printf("check   E192 %zu values, %s trim, %zu ratios x %zu loads: best error same as the brute force\n", values.size(),
+               trim ? "with" : "without", sizeof(ratios)/sizeof(ratios[0]), sizeof(loads)/sizeof(loads[0]));
+    }
+
+    printf("design  %zu queries: %.3f ms average, %.3f ms slowest (budget %.2f ms)\n", queries, total/queries, slowest, frameBudget);
+    return 0;
+}
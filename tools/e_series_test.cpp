@@ -0,0 +1,134 @@
+// Host test of the nearest standard value index (e_series.h). For every series, nearest() and
+// nearestBatch() must return the closest value in log distance of a linear scan over all the
+// series values, for random values from 0.01 ohm to 10 Tohm (below the smallest and above the
+// largest standard value included), decade edges and the midpoints between neighbouring values.
+// Then times batch and single lookups, as for a BOM of standard values.
+//
+//   e_series_test [values]
+//
+// Default 200000 random values per series. Exits non-zero on the first mismatch.
+
+#include "e_series.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace resistor;
+
+// The index keeps its log tables in floats: a value within this distance (in log10) of the
+// closest one is a tie, either answer is right
+constexpr double logTolerance = 1e-6;
+
+static double logDistance(double a, double b)
+{
+    return std::fabs(std::log10(a) - std::log10(b));
+}
+
+// Linear scan of every value of the series (logs is log10 of each), the first of two equal
+// distances wins
+static double bruteForceNearest(const std::vector<double>& values, const std::vector<double>& logs, double target)
+{
+    if (!(target > 0.0)) return values.front();
+
+    double targetLog = std::log10(target);
+    size_t best = 0;
+    for (size_t i = 1; i < values.size(); i++) {
+        if (std::fabs(logs[i] - targetLog) < std::fabs(logs[best] - targetLog)) best = i;
+    }
+    return values[best];
+}
+
+static bool checkValue(const char* name, ESeries series, const std::vector<double>& values, const std::vector<double>& logs,
+                       double target, const StandardValue& result)
+{
+    double expected = bruteForceNearest(values, logs, target);
+    bool member = std::binary_search(values.begin(), values.end(), (double)result.ohms);
+    bool bands = (result.ohms == (uint64_t)result.significand*powerOf10(result.exponent)) &&
+                 (result.digitCount == seriesInfo[series].digitCount) && (result.exponent <= maxExponent);
+    bool closest = !(target > 0.0) ? ((double)result.ohms == expected)
+                                   : (logDistance((double)result.ohms, target) <= logDistance(expected, target) + logTolerance);
+
+    if (!member || !bands || !closest) {
+        fprintf(stderr, "e_series_test: E%u %s: %.9g ohms gives %llu (%u, x10^%u), expected %.9g\n", seriesInfo[series].count,
+                name, target, (unsigned long long)result.ohms, result.significand, result.exponent, expected);
+        return false;
+    }
+    return true;
+}
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    size_t randomCount = (argc > 1) ? (size_t)atol(argv[1]) : 200000;
+    static const StandardValueIndex index;
+    std::mt19937_64 random(1);
+    std::uniform_real_distribution<double> logUniform(-2.0, 13.0);
+
+    for (uint8_t s = 0; s < SeriesCount; s++) {
+        ESeries series = (ESeries)s;
+        std::vector<double> values = seriesValues(series);
+        std::vector<double> logs(values.size());
+        for (size_t i = 0; i < values.size(); i++) logs[i] = std::log10(values[i]);
+
+        // Edges: out of range and non positive values, every power of ten and both sides of it,
+        // both sides of every midpoint between neighbours (decade boundaries included)
+        std::vector<double> targets = { -5.0, 0.0, 1e-3, 0.5, 1.0, 9.99, 1e12, 5e12, 1e15 };
+        for (int exponent = 0; exponent <= 12; exponent++) {
+            double power = std::pow(10.0, exponent);
+            targets.insert(targets.end(), { power*(1 - 1e-9), power, power*(1 + 1e-9) });
+        }
+        for (size_t i = 0; i + 1 < values.size(); i++) {
+            double midpoint = std::sqrt(values[i]*values[i + 1]);
+            targets.insert(targets.end(), { midpoint*(1 - 1e-5), midpoint, midpoint*(1 + 1e-5) });
+        }
+        size_t edgeCount = targets.size();
+        for (size_t i = 0; i < randomCount; i++) targets.push_back(std::pow(10.0, logUniform(random)));
+
+        // Not a multiple of the batch width, so the last block of nearestBatch() is partial
+        if (targets.size()%StandardValueIndex::batchWidth == 0) targets.push_back(47.0);
+
+        std::vector<StandardValue> batch(targets.size());
+        index.nearestBatch(series, targets.data(), batch.data(), targets.size());
+
+        for (size_t i = 0; i < targets.size(); i++) {
+            StandardValue single = index.nearest(series, targets[i]);
+            if (!checkValue("nearest()", series, values, logs, targets[i], single)) return 1;
+            if (batch[i].ohms != single.ohms || batch[i].error != single.error) {
+                fprintf(stderr, "e_series_test: E%u nearestBatch(): %.9g ohms gives %llu, nearest() %llu\n", seriesInfo[series].count,
+                        targets[i], (unsigned long long)batch[i].ohms, (unsigned long long)single.ohms);
+                return 1;
+            }
+        }
+
+        // Timing over the random values only, best of 3 runs each
+        std::vector<double> lookups(targets.begin() + edgeCount, targets.end());
+        double batchTime = 1e30, singleTime = 1e30;
+        uint64_t sum = 0;
+        for (int run = 0; run < 3; run++) {
+            auto start = std::chrono::steady_clock::now();
+            index.nearestBatch(series, lookups.data(), batch.data(), lookups.size());
+            batchTime = std::min(batchTime, elapsedSeconds(start));
+            sum += batch[lookups.size() - 1].ohms;
+
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < lookups.size(); i++) batch[i] = index.nearest(series, lookups[i]);
+            singleTime = std::min(singleTime, elapsedSeconds(start));
+            sum += batch[lookups.size() - 1].ohms;
+        }
+
+        printf("check   E%-3u %zu edge and %zu random values: same as a linear scan\n", seriesInfo[series].count, edgeCount,
+               targets.size() - edgeCount);
+        printf("lookup  E%-3u batch %6.1f M values/s, single %6.1f M values/s  (%llu)\n", seriesInfo[series].count,
+               lookups.size()/batchTime/1e6, lookups.size()/singleTime/1e6, (unsigned long long)sum);
+    }
+    return 0;
+}
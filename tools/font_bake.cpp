@@ -0,0 +1,195 @@
+// Bakes a TTF font into a raylib baked font file (.rfnt, ExportFontBaked() in rtext.c) host side,
+// so the app loads glyph metrics and atlas pixels as they are instead of rasterizing the TTF on
+// every launch. Copy the result to the app assets.
+//
+//   font_bake [--sdf] [--compress] font.ttf size output.rfnt [first-last ...]
+//
+// Ranges are codepoints, decimal or 0x hex ("32-126"), default Basic Latin. --sdf bakes a signed
+// distance field atlas like LoadFontSDF(), --compress stores the atlas DEFLATE compressed (sdefl).
+// The baked file is then loaded back through LoadFontFromMemory(), checked against the TTF load
+// and both loads are timed, file reading included, GPU upload excluded.
+
+#include "raylib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// rtext.c and rtextures.c are built without rcore: no GPU, and the deflate implementations rcore
+// provides with SUPPORT_COMPRESSION_API are compiled here
+#define SDEFL_IMPLEMENTATION
+#include "external/sdefl.h"
+#define SINFL_IMPLEMENTATION
+#define SINFL_NO_SIMD
+#include "external/sinfl.h"
+
+extern "C" {
+bool isGpuReady = false;
+
+unsigned int rlLoadTexture(const void*, int, int, int, int)
+{
+    return 0;
+}
+
+void rlUnloadTexture(unsigned int)
+{
+}
+
+void rlTextureParameters(unsigned int, int, int)
+{
+}
+}
+
+static Font loadFont(const char* fileName, const char* fileType, int fontSize, std::vector<int>& codepoints, bool sdf)
+{
+    if (sdf && strcmp(fileType, ".ttf") == 0) return LoadFontSDF(fileName, fontSize, codepoints.data(), (int)codepoints.size());
+
+    int dataSize = 0;
+    unsigned char* fileData = LoadFileData(fileName, &dataSize);
+    Font font = LoadFontFromMemory(fileType, fileData, dataSize, fontSize, codepoints.data(), (int)codepoints.size());
+    UnloadFileData(fileData);
+    return font;
+}
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool parseRange(const char* text, std::vector<int>& codepoints)
+{
+    char* end = nullptr;
+    long first = strtol(text, &end, 0);
+    if (*end != '-') return false;
+    long last = strtol(end + 1, &end, 0);
+    if (*end != '\0' || first < 0 || last < first || last > 0x10ffff) return false;
+
+    for (long codepoint = first; codepoint <= last; codepoint++) codepoints.push_back((int)codepoint);
+    return true;
+}
+
+static bool sameFont(const Font& a, const Font& b)
+{
+    if (a.baseSize != b.baseSize || a.glyphCount != b.glyphCount || a.glyphPadding != b.glyphPadding || a.type != b.type) return false;
+    for (int i = 0; i < a.glyphCount; i++) {
+        if (a.glyphs[i].value != b.glyphs[i].value || a.glyphs[i].offsetX != b.glyphs[i].offsetX ||
+            a.glyphs[i].offsetY != b.glyphs[i].offsetY || a.glyphs[i].advanceX != b.glyphs[i].advanceX ||
+            memcmp(&a.recs[i], &b.recs[i], sizeof(Rectangle)) != 0) return false;
+    }
+    return true;
+}
+
+// Atlas pixels of a baked file, inflated when compressed. The header is 11 ints, then 32 bytes per glyph.
+static bool sameAtlas(const char* fileName, const Image& atlas)
+{
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(fileName, &dataSize);
+    if (data == nullptr) return false;
+
+    int header[11];
+    memcpy(header, data, sizeof(header));
+    int glyphCount = header[3];
+    bool compressed = header[9] != 0;
+    int atlasDataSize = header[10];
+    const unsigned char* atlasData = data + sizeof(header) + (size_t)glyphCount*32;
+
+    int pixelDataSize = GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    std::vector<unsigned char> pixels(pixelDataSize);
+    bool ok = header[6] == atlas.width && header[7] == atlas.height && header[8] == atlas.format;
+    if (compressed) ok &= sinflate(pixels.data(), pixelDataSize, atlasData, atlasDataSize) == pixelDataSize;
+    else if (ok && atlasDataSize == pixelDataSize) memcpy(pixels.data(), atlasData, pixelDataSize);
+    else ok = false;
+    ok &= memcmp(pixels.data(), atlas.data, pixelDataSize) == 0;
+
+    UnloadFileData(data);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    bool sdf = false;
+    bool compressed = false;
+    char** args = argv;
+    int count = argc;
+    for (; count > 1 && args[1][0] == '-' && args[1][1] == '-'; args++, count--) {
+        if (strcmp(args[1], "--sdf") == 0) sdf = true;
+        else if (strcmp(args[1], "--compress") == 0) compressed = true;
+        else break;
+    }
+
+    if (count < 4 || args[1][0] == '-') {
+        fprintf(stderr, "usage: font_bake [--sdf] [--compress] font.ttf size output.rfnt [first-last ...]\n");
+        return 2;
+    }
+
+    const char* fontName = args[1];
+    int fontSize = atoi(args[2]);
+    const char* outputName = args[3];
+    std::vector<int> codepoints;
+    for (int i = 4; i < count; i++) {
+        if (!parseRange(args[i], codepoints)) {
+            fprintf(stderr, "font_bake: bad codepoint range '%s'\n", args[i]);
+            return 2;
+        }
+    }
+    if (codepoints.empty()) parseRange("32-126", codepoints);
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Same steps as LoadFontFromMemory() or LoadFontSDF(), keeping the atlas image the texture
+    // would be loaded from
+    int dataSize = 0;
+    unsigned char* fileData = LoadFileData(fontName, &dataSize);
+    Font font = {};
+    font.baseSize = fontSize;
+    font.glyphCount = (int)codepoints.size();
+    font.glyphPadding = sdf ? 0 : 4;       // FONT_TTF_DEFAULT_CHARS_PADDING
+    font.texture = {};                      // Not uploaded, the atlas image is exported instead
+    font.recs = nullptr;
+    font.glyphTable = nullptr;              // No lookups, the font is only exported
+    font.type = sdf ? FONT_SDF : FONT_DEFAULT;
+    font.glyphs = LoadFontData(fileData, dataSize, fontSize, codepoints.data(), font.glyphCount, font.type);
+    UnloadFileData(fileData);
+    if (fontSize <= 0 || font.glyphs == nullptr) {
+        fprintf(stderr, "font_bake: cannot load '%s' at size %d\n", fontName, fontSize);
+        return 1;
+    }
+
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, sdf ? 1 : 0);
+    if (!ExportFontBaked(font, atlas, compressed, outputName)) {
+        fprintf(stderr, "font_bake: cannot write '%s'\n", outputName);
+        return 1;
+    }
+
+    int bakedSize = 0;
+    UnloadFileData(LoadFileData(outputName, &bakedSize));
+    printf("%s: %d %sglyphs at %d px, atlas %dx%d, %d bytes%s\n", outputName, font.glyphCount, sdf ? "SDF " : "",
+           fontSize, atlas.width, atlas.height, bakedSize, compressed ? " (compressed)" : "");
+
+    // Both loads as LoadFontEx() or LoadFontSDF() do them, best of 5
+    double ttfTime = 1e30, bakedTime = 1e30;
+    Font ttf = {}, baked = {};
+    for (int run = 0; run < 5; run++) {
+        UnloadFont(ttf);
+        UnloadFont(baked);
+        auto start = std::chrono::steady_clock::now();
+        ttf = loadFont(fontName, ".ttf", fontSize, codepoints, sdf);
+        ttfTime = std::min(ttfTime, elapsedMilliseconds(start));
+        start = std::chrono::steady_clock::now();
+        baked = loadFont(outputName, ".rfnt", 0, codepoints, sdf);
+        bakedTime = std::min(bakedTime, elapsedMilliseconds(start));
+    }
+
+    bool ok = sameFont(ttf, baked) && sameFont(font, baked) && sameAtlas(outputName, atlas);
+    printf("load    ttf %.2f ms, baked %.3f ms (GPU upload excluded)\n", ttfTime, bakedTime);
+    printf("check   %s\n", ok ? "same glyphs, recs and atlas" : "MISMATCH");
+
+    UnloadFont(ttf);
+    UnloadFont(baked);
+    UnloadFont(font);
+    UnloadImage(atlas);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Glyph rasterization benchmark of LoadFontData() (raylib rtext.c, built here without the GPU
+// modules), host side. Loads the glyphs with 1, 2, 4 and 8 threads and checks every thread
+// count produces the same glyphs as the single threaded load.
+//
+//   font_load_bench font.ttf [size] [first-last ...]
+//
+// Ranges are codepoints, decimal or 0x hex ("32-126"). Default: size 126, Basic Latin, Latin-1,
+// Latin Extended A/B, Greek and Cyrillic.
+
+#include "raylib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// rtext.c logs through raylib's TraceLog(), rcore is not linked
+extern "C" void TraceLog(int logLevel, const char* text, ...)
+{
+    if (logLevel < LOG_WARNING) return;
+    va_list args;
+    va_start(args, text);
+    vfprintf(stderr, text, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+static bool parseRange(const char* text, std::vector<int>& codepoints)
+{
+    char* end = nullptr;
+    long first = strtol(text, &end, 0);
+    if (*end != '-') return false;
+    long last = strtol(end + 1, &end, 0);
+    if (*end != '\0' || first < 0 || last < first || last > 0x10ffff) return false;
+
+    for (long codepoint = first; codepoint <= last; codepoint++) codepoints.push_back((int)codepoint);
+    return true;
+}
+
+static void freeGlyphs(GlyphInfo* glyphs, int count)
+{
+    if (glyphs == nullptr) return;
+    for (int i = 0; i < count; i++) free(glyphs[i].image.data);
+    free(glyphs);
+}
+
+static bool sameGlyphs(const GlyphInfo* a, const GlyphInfo* b, int count)
+{
+    for (int i = 0; i < count; i++) {
+        const Image& imageA = a[i].image;
+        const Image& imageB = b[i].image;
+        if (a[i].value != b[i].value || a[i].offsetX != b[i].offsetX || a[i].offsetY != b[i].offsetY ||
+            a[i].advanceX != b[i].advanceX || imageA.width != imageB.width || imageA.height != imageB.height ||
+            (imageA.data == nullptr) != (imageB.data == nullptr)) return false;
+
+        // Space glyphs are 2 bytes per pixel, see LoadFontData()
+        size_t bytes = (size_t)imageA.width*imageA.height*((a[i].value == ' ') ? 2 : 1);
+        if (imageA.data != nullptr && memcmp(imageA.data, imageB.data, bytes) != 0) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: font_load_bench font.ttf [size] [first-last ...]\n");
+        return 2;
+    }
+
+    int fontSize = (argc > 2) ? atoi(argv[2]) : 126;
+    std::vector<int> codepoints;
+    for (int i = 3; i < argc; i++) {
+        if (!parseRange(argv[i], codepoints)) {
+            fprintf(stderr, "font_load_bench: bad codepoint range '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (codepoints.empty()) {
+        parseRange("32-126", codepoints);
+        parseRange("160-591", codepoints);
+        parseRange("880-1279", codepoints);
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "font_load_bench: cannot open '%s'\n", argv[1]);
+        return 1;
+    }
+    std::vector<unsigned char> data;
+    unsigned char chunk[65536];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) data.insert(data.end(), chunk, chunk + read);
+    fclose(file);
+
+    int count = (int)codepoints.size();
+    printf("%s: %d codepoints at %d px, %u cores\n", argv[1], count, fontSize, std::thread::hardware_concurrency());
+
+    GlyphInfo* reference = nullptr;
+    double single = 0.0;
+    bool ok = true;
+
+    for (int threads : { 1, 2, 4, 8 }) {
+        SetFontLoadThreads(threads);
+
+        // Best of 3 loads
+        double best = 1e30;
+        GlyphInfo* glyphs = nullptr;
+        for (int run = 0; run < 3; run++) {
+            freeGlyphs(glyphs, count);
+            auto start = std::chrono::steady_clock::now();
+            glyphs = LoadFontData(data.data(), (int)data.size(), fontSize, codepoints.data(), count, FONT_DEFAULT);
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        if (glyphs == nullptr) {
+            fprintf(stderr, "font_load_bench: '%s' is not a TTF font\n", argv[1]);
+            return 1;
+        }
+
+        bool same = true;
+        if (reference == nullptr) {
+            reference = glyphs;
+            single = best;
+        }
+        else {
+            same = sameGlyphs(reference, glyphs, count);
+            freeGlyphs(glyphs, count);
+        }
+        ok &= same;
+
+        printf("%d thread%s %8.1f ms  x%.2f  %s\n", threads, (threads > 1) ? "s" : " ", best, single/best, same ? "same glyphs" : "MISMATCH");
+    }
+
+    freeGlyphs(reference, count);
+    return ok ? 0 : 1;
+}
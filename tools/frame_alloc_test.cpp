@@ -0,0 +1,249 @@
+// Steady-state allocation test of the calculator, host side. main.cpp runs unchanged with allocation
+// tracking on, over raylib's rshapes.c, rtext.c and rtextures.c. The platform and GPU layers (rcore,
+// rlgl) are replaced below by a scripted touch sequence and a vertex copy, so every frame goes through
+// the app's update and draw code and raylib's shape and text submission.
+//
+//   frame_alloc_test          (run from app/src/main/assets, it loads Cubano.rfnt)
+//
+// The script focuses every band and presses every color button on it, holds and drags touches,
+// clears a band and resizes the screen. Exits non-zero when any steady-state frame allocated.
+
+#include "raylib.h"
+#include "alloc_tracker.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Deflate decompressor of baked font atlases, compiled in rcore.c in the app
+#define SINFL_IMPLEMENTATION
+#define SINFL_NO_SIMD
+#include "external/sinfl.h"
+
+// Touch script, one step per touch or pause, in layout coordinates (the screen starts at the
+// layout size so they are also screen coordinates until the resize)
+struct ScriptStep {
+    Vector2 position;
+    bool down;
+    int frames;
+};
+
+static std::vector<ScriptStep> script;
+static size_t step = 0;
+static int stepFrame = 0;
+static uint32_t frame = 0;
+
+static Vector2 mouse = { 0 };
+static bool mouseDown = false;
+static bool mousePressed = false;
+static int screenWidth = 720;
+static int screenHeight = 1280;
+
+static uint32_t allocatingFrames = 0;
+
+static void tap(Vector2 position, int frames)
+{
+    script.push_back((ScriptStep){ position, true, frames });
+    script.push_back((ScriptStep){ position, false, 3 });
+}
+
+// Band and button centers of main.cpp's layout
+static Vector2 bandCenter(int band)
+{
+    const float x[4] = { 130, 240, 350, 525 };
+    return (Vector2){ x[band] + 35, 200 };
+}
+
+static Vector2 buttonCenter(int button)
+{
+    if (button == 9) return (Vector2){ 160, 510 };
+    return (Vector2){ 160.0f + 200*(button%3), 710.0f + 200*(button/3) };
+}
+
+static void buildScript()
+{
+    script.push_back((ScriptStep){ (Vector2){ 0, 0 }, false, 10 });
+    for (int band = 0; band < 4; band++) {
+        tap(bandCenter(band), 2);
+        for (int button = 0; button < 10; button++) tap(buttonCenter(button), 4);
+    }
+
+    // Held touch dragged over the buttons and off the panel, then a band cleared
+    for (int button = 0; button < 10; button++) script.push_back((ScriptStep){ buttonCenter(button), true, 2 });
+    script.push_back((ScriptStep){ (Vector2){ 5, 5 }, true, 2 });
+    script.push_back((ScriptStep){ (Vector2){ 5, 5 }, false, 5 });
+    tap(bandCenter(3), 2);
+    tap(bandCenter(3), 2);
+    script.push_back((ScriptStep){ (Vector2){ 0, 0 }, false, 30 });
+}
+
+extern "C" {
+
+//----------------------------------------------------------------------------------
+// rcore: window, frame and scripted input
+//----------------------------------------------------------------------------------
+void InitWindow(int, int, const char*)
+{
+    buildScript();
+}
+
+bool WindowShouldClose(void)
+{
+    while (step < script.size() && stepFrame >= script[step].frames) {
+        step++;
+        stepFrame = 0;
+    }
+    if (step == script.size()) return true;
+
+    // Screen resized to a taller phone halfway through the last pause
+    if ((step == script.size() - 1) && (stepFrame == script[step].frames/2)) {
+        screenWidth = 1080;
+        screenHeight = 2400;
+    }
+
+    const ScriptStep& current = script[step];
+    mousePressed = current.down && !mouseDown;
+    mouseDown = current.down;
+    if (current.down) mouse = current.position;
+    stepFrame++;
+    return false;
+}
+
+void CloseWindow(void)
+{
+    uint32_t steadyAllocating = getAllocatingFrameCount();
+    printf("frames  %u frames, %u allocated (warmup, band changes, resize), %u steady-state frames allocated\n",
+           frame, allocatingFrames, steadyAllocating);
+    if (steadyAllocating > 0) exit(1);
+}
+
+void SetTargetFPS(int) {}
+float GetFrameTime(void) { return 1.0f/60.0f; }
+int GetScreenWidth(void) { return screenWidth; }
+int GetScreenHeight(void) { return screenHeight; }
+Vector2 GetMousePosition(void) { return mouse; }
+bool IsMouseButtonDown(int) { return mouseDown; }
+bool IsMouseButtonPressed(int) { return mousePressed; }
+void PollInputEvents(void) {}
+void EnableEventWaiting(void) {}
+void DisableEventWaiting(void) {}
+bool FileExists(const char*) { return false; }
+
+const char* GetFileExtension(const char* fileName)
+{
+    const char* dot = strrchr(fileName, '.');
+    return (dot == NULL || dot == fileName) ? NULL : dot;
+}
+
+// raymob: every frame is drawn, no cache directory (no photo, no inventory)
+void SetEventWaitTimeout(int) {}
+bool IsRedrawRequested(void) { return true; }
+char* GetCacheDir(void) { return NULL; }
+
+void BeginDrawing(void) {}
+void ClearBackground(Color) {}
+void BeginMode2D(Camera2D) {}
+void EndMode2D(void) {}
+void BeginTextureMode(RenderTexture2D) {}
+void EndTextureMode(void) {}
+
+void EndDrawing(void)
+{
+    AllocationStats stats = getAllocationStats();
+    for (int i = 0; i < ALLOC_MODULE_COUNT; i++) {
+        if (stats.count[i] == 0) continue;
+        allocatingFrames++;
+        break;
+    }
+    frame++;
+}
+
+Shader LoadShaderFromMemory(const char*, const char*)
+{
+    static int locations[RL_MAX_SHADER_LOCATIONS] = { 0 };
+    return (Shader){ 1, locations };
+}
+
+void UnloadShader(Shader) {}
+int GetShaderLocation(Shader, const char*) { return 0; }
+void SetShaderValue(Shader, int, const void*, int) {}
+void BeginShaderMode(Shader) {}
+void EndShaderMode(void) {}
+
+//----------------------------------------------------------------------------------
+// rlgl: textures and framebuffers are ids only, vertices go to a fixed batch
+//----------------------------------------------------------------------------------
+bool isGpuReady = true;
+
+struct BatchVertex {
+    float x, y, z;
+    float u, v;
+    float nx, ny, nz;
+    unsigned char color[4];
+};
+
+static BatchVertex batch[8192];
+static int batchCount = 0;
+static BatchVertex state = { 0 };
+
+unsigned int rlLoadTexture(const void*, int, int, int, int) { return 1; }
+unsigned int rlLoadTextureDepth(int, int, bool) { return 1; }
+void rlUnloadTexture(unsigned int) {}
+void rlTextureParameters(unsigned int, int, int) {}
+void rlGenTextureMipmaps(unsigned int, int, int, int, int*) {}
+unsigned int rlLoadFramebuffer(void) { return 1; }
+void rlUnloadFramebuffer(unsigned int) {}
+void rlFramebufferAttach(unsigned int, unsigned int, int, int, int) {}
+bool rlFramebufferComplete(unsigned int) { return true; }
+void rlEnableFramebuffer(unsigned int) {}
+void rlDisableFramebuffer(void) {}
+unsigned int rlGetTextureIdDefault(void) { return 1; }
+const char* rlGetPixelFormatName(unsigned int) { return "UNKNOWN"; }
+
+void rlBegin(int) {}
+void rlEnd(void) {}
+void rlSetTexture(unsigned int) {}
+bool rlCheckRenderBatchLimit(int) { return false; }
+void rlPushMatrix(void) {}
+void rlPopMatrix(void) {}
+void rlTranslatef(float, float, float) {}
+void rlRotatef(float, float, float, float) {}
+void rlScalef(float, float, float) {}
+
+void rlNormal3f(float x, float y, float z)
+{
+    state.nx = x;
+    state.ny = y;
+    state.nz = z;
+}
+
+void rlTexCoord2f(float x, float y)
+{
+    state.u = x;
+    state.v = y;
+}
+
+void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+    state.color[0] = r;
+    state.color[1] = g;
+    state.color[2] = b;
+    state.color[3] = a;
+}
+
+void rlVertex3f(float x, float y, float z)
+{
+    state.x = x;
+    state.y = y;
+    state.z = z;
+    batch[batchCount] = state;
+    batchCount = (batchCount + 1)%(int)(sizeof(batch)/sizeof(batch[0]));
+}
+
+void rlVertex2f(float x, float y)
+{
+    rlVertex3f(x, y, 0.0f);
+}
+
+}
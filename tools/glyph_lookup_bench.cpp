@@ -0,0 +1,141 @@
+// Glyph index lookup check and benchmark of raylib's rtext.c (built here without the GPU modules
+// and without the text layout cache), host side. Fonts of 95 to 20000 glyphs (ASCII, Latin
+// Extended, Cyrillic, CJK and emoji out of the BMP) are baked to .rfnt files and loaded back with
+// LoadFontFromMemory(), which builds their glyph index table. For every codepoint up to 0x20000
+// GetGlyphIndex() must return the same glyph with the table as with the linear search, then
+// DrawTextEx() of a mixed script string is timed both ways.
+//
+//   glyph_lookup_bench [draws]
+//
+// Default 20000 draws per font. The .rfnt files are written to the working directory.
+
+#include "raylib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Glyph quads are counted, not drawn
+static long quads = 0;
+
+extern "C" {
+bool isGpuReady = false;
+
+void DrawTexturePro(Texture2D, Rectangle, Rectangle dest, Vector2, float, Color)
+{
+    quads += (dest.width > 0);
+}
+
+int GetPixelDataSize(int width, int height, int format)
+{
+    return (format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) ? width*height : 0;
+}
+
+void SetTextureFilter(Texture2D, int) {}
+void UnloadTexture(Texture2D) {}
+void UnloadImage(Image) {}
+
+// Only reached with the GPU ready, by SDF fonts and by text layouts, none used here
+unsigned int rlLoadTexture(const void*, int, int, int, int) { return 0; }
+void rlSetTexture(unsigned int) {}
+void rlBegin(int) {}
+void rlEnd(void) {}
+void rlNormal3f(float, float, float) {}
+void rlTexCoord2f(float, float) {}
+void rlColor4ub(unsigned char, unsigned char, unsigned char, unsigned char) {}
+void rlVertex2f(float, float) {}
+}
+
+// Glyph i of the generated fonts, '?' included for the fallback
+static int codepointAt(int i)
+{
+    if (i < 95) return 32 + i;                          // ASCII
+    if (i < 431) return 0x100 + (i - 95);               // Latin Extended A/B
+    if (i < 687) return 0x400 + (i - 431);              // Cyrillic
+    if (i < 751) return 0x1f600 + (i - 687);            // Emoji, out of the BMP
+    return 0x4e00 + (i - 751);                          // CJK
+}
+
+static Font loadGeneratedFont(int glyphCount, const char* fileName)
+{
+    std::vector<GlyphInfo> glyphs(glyphCount);
+    std::vector<Rectangle> recs(glyphCount, (Rectangle){ 0, 0, 8, 10 });
+    for (int i = 0; i < glyphCount; i++) {
+        glyphs[i].value = codepointAt(i);
+        glyphs[i].advanceX = 10;
+    }
+    glyphs[glyphCount - 1].value = 'A';     // Duplicate codepoint, the first glyph must win
+
+    Font font = {};
+    font.baseSize = 32;
+    font.glyphCount = glyphCount;
+    font.glyphs = glyphs.data();
+    font.recs = recs.data();
+
+    unsigned char pixel = 255;
+    Image atlas = { &pixel, 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    if (!ExportFontBaked(font, atlas, false, fileName)) return (Font){};
+
+    int dataSize = 0;
+    unsigned char* fileData = LoadFileData(fileName, &dataSize);
+    Font loaded = LoadFontFromMemory(".rfnt", fileData, dataSize, 0, NULL, 0);
+    UnloadFileData(fileData);
+    loaded.texture.id = 1;      // Not uploaded, DrawTextEx() only needs it non zero
+    return loaded;
+}
+
+int main(int argc, char** argv)
+{
+    int draws = (argc > 1) ? atoi(argv[1]) : 20000;
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Latin, Cyrillic, Polish, an emoji, CJK and two codepoints no font has (the euro sign and U+10000)
+    const char* text = "Widerstand 4.7k \xd0\xa1\xd0\xbe\xd0\xbf\xd1\x80\xd0\xbe\xd1\x82\xd0\xb8\xd0\xb2\xd0\xbb\xd0\xb5"
+                       "\xd0\xbd\xd0\xb8\xd0\xb5 \xc5\x81\xc3\xb3\x64\xc5\xba \xf0\x9f\x98\x80 \xe4\xb8\x80\xe4\xb8\x87 "
+                       "\xe2\x82\xac\xf0\x90\x80\x80";
+    int textCodepoints = GetCodepointCount(text);
+
+    for (int glyphCount : { 95, 700, 2000, 8000, 20000 }) {
+        char fileName[64];
+        snprintf(fileName, sizeof(fileName), "glyph_lookup_%i.rfnt", glyphCount);
+        Font font = loadGeneratedFont(glyphCount, fileName);
+        if (font.glyphTable == NULL) {
+            fprintf(stderr, "glyph_lookup_bench: %i glyphs: font not loaded or without glyph table\n", glyphCount);
+            return 1;
+        }
+
+        Font linear = font;
+        linear.glyphTable = NULL;
+
+        for (int codepoint = -3; codepoint < 0x20000; codepoint++) {
+            int index = GetGlyphIndex(font, codepoint);
+            int expected = GetGlyphIndex(linear, codepoint);
+            if (index != expected) {
+                fprintf(stderr, "glyph_lookup_bench: %i glyphs, codepoint 0x%x: glyph %i, linear search %i\n", glyphCount, codepoint, index, expected);
+                return 1;
+            }
+        }
+
+        // Best of 3 runs each
+        double times[2] = { 1e30, 1e30 };
+        for (int run = 0; run < 3; run++) {
+            for (int mode = 0; mode < 2; mode++) {
+                Font drawn = (mode == 0) ? linear : font;
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < draws; i++) DrawTextEx(drawn, text, (Vector2){ 0, 0 }, 32, 1, WHITE);
+                times[mode] = std::min(times[mode], std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count()/draws);
+            }
+        }
+
+        printf("glyphs  %5i: same glyph as the linear search up to 0x20000, DrawTextEx() of %i codepoints: linear %6.2f us, table %5.2f us\n",
+               glyphCount, textCodepoints, times[0], times[1]);
+
+        font.texture.id = 0;
+        UnloadFont(font);
+        remove(fileName);
+    }
+
+    return (quads > 0) ? 0 : 1;
+}
@@ -0,0 +1,7 @@
+// Host stand-in for the NDK header included by raymob.h, only the declaration raymob.h uses
+#ifndef ANDROID_NATIVE_APP_GLUE_H
+#define ANDROID_NATIVE_APP_GLUE_H
+
+struct android_app;
+
+#endif // ANDROID_NATIVE_APP_GLUE_H
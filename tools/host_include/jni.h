@@ -0,0 +1,10 @@
+// Host stand-in for the NDK header included by raymob.h, only the types raymob.h uses
+#ifndef JNI_H
+#define JNI_H
+
+#include <stdint.h>      // Included by the NDK header, raymob.h relies on it
+
+typedef void* JNIEnv;
+typedef void* jobject;
+
+#endif // JNI_H
@@ -0,0 +1,173 @@
+// Builds the parts inventory base file (inventory.h) from a CSV export, host side, so the app
+// never parses CSV at startup. Copy the result to the app cache directory.
+//
+//   inventory_build inventory.csv inventory.bin
+//   inventory_build --bench N directory
+//
+// CSV lines are "value,quantity,location": the value in ohms with an optional k/M/G suffix
+// ("4k7", "4.7k", "100", "2R2"), the location up to 27 characters ("Drawer A3"). Lines starting
+// with '#' are comments. --bench writes N random records to directory/inventory.bin, then times
+// opening it and looking values up against std::lower_bound.
+
+#include "e_series.h"
+#include "inventory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace resistor;
+
+static double elapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// "4k7", "4.7k", "2R2", "100" -> milliohms, false on anything else
+static bool parseValue(const char* text, uint64_t& milliohms)
+{
+    double value = 0.0;
+    double scale = 1.0;
+    double fraction = 0.0;          // Place value of the next digit after the separator, 0 before it
+    bool digits = false;
+    bool suffix = false;
+
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c >= '0' && *c <= '9') {
+            if (fraction > 0.0) {
+                value += (*c - '0')*fraction;
+                fraction /= 10.0;
+            }
+            else value = value*10.0 + (*c - '0');
+            digits = true;
+            continue;
+        }
+
+        // One decimal point or multiplier letter inside the digits, a multiplier may also end a
+        // value with a decimal point
+        bool last = c[1] == '\0';
+        if (suffix || (fraction > 0.0 && (*c == '.' || !last))) return false;
+        switch (*c) {
+            case '.': break;
+            case 'R': case 'r': suffix = true; break;
+            case 'k': case 'K': scale = 1e3; suffix = true; break;
+            case 'M': scale = 1e6; suffix = true; break;
+            case 'G': case 'g': scale = 1e9; suffix = true; break;
+            default: return false;
+        }
+        if (fraction == 0.0) fraction = 0.1;
+    }
+
+    if (!digits) return false;
+    milliohms = (uint64_t)std::llround(value*scale*1000.0);
+    return true;
+}
+
+static bool loadCsv(const char* fileName, std::vector<InventoryEntry>& entries)
+{
+    FILE* file = fopen(fileName, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "inventory_build: cannot open '%s'\n", fileName);
+        return false;
+    }
+
+    char line[256];
+    int lineNumber = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        lineNumber++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0') continue;
+
+        char value[32], location[64] = "";
+        unsigned quantity;
+        uint64_t milliohms;
+        if (sscanf(line, "%31[^,],%u,%63[^\n]", value, &quantity, location) < 2 || !parseValue(value, milliohms)) {
+            fprintf(stderr, "inventory_build: %s:%d: expected \"value,quantity,location\"\n", fileName, lineNumber);
+            ok = false;
+            continue;
+        }
+        if (strlen(location) >= inventoryLocationSize)
+            fprintf(stderr, "inventory_build: %s:%d: location '%s' truncated\n", fileName, lineNumber, location);
+        entries.push_back({ milliohms, quantity, location });
+    }
+    fclose(file);
+    return ok;
+}
+
+static bool runBench(size_t count, const char* directory)
+{
+    // E96 values over 9 decades, spread over 1000 bins
+    std::vector<double> values = seriesValues(E96, 0, 9);
+    std::mt19937_64 random(1);
+    std::vector<InventoryEntry> entries(count);
+    char location[inventoryLocationSize];
+    for (InventoryEntry& entry : entries) {
+        snprintf(location, sizeof(location), "Bin %u", (unsigned)(random() % 1000));
+        entry = { (uint64_t)(values[random() % values.size()]*1000.0) + random() % 1000, (uint32_t)(random() % 500 + 1), location };
+    }
+
+    std::string path = std::string(directory) + "/" + inventoryFileName;
+    auto start = std::chrono::steady_clock::now();
+    if (!writeInventory(path.c_str(), entries)) {
+        fprintf(stderr, "inventory_build: cannot write '%s'\n", path.c_str());
+        return false;
+    }
+    printf("write   %zu entries: %.1f ms\n", count, elapsedMicroseconds(start)/1000.0);
+
+    Inventory inventory;
+    start = std::chrono::steady_clock::now();
+    bool ok = inventory.open(directory);
+    printf("open    %zu records: %.1f us\n", inventory.getRecordCount(), elapsedMicroseconds(start));
+    if (!ok) return false;
+
+    // Reference: plain binary search over the sorted entries
+    std::sort(entries.begin(), entries.end(), [](const InventoryEntry& a, const InventoryEntry& b) {
+        return a.milliohms < b.milliohms;
+    });
+
+    constexpr size_t lookups = 1000000;
+    std::vector<uint64_t> queries(lookups);
+    for (uint64_t& query : queries) query = (random() % 4 == 0) ? random() % 1000000000000ull : entries[random() % entries.size()].milliohms;
+
+    start = std::chrono::steady_clock::now();
+    uint64_t total = 0;
+    for (uint64_t query : queries) total += inventory.quantity(query);
+    double elapsed = elapsedMicroseconds(start);
+    printf("lookup  %zu values: %.3f us each\n", lookups, elapsed/lookups);
+
+    uint64_t expected = 0;
+    for (uint64_t query : queries) {
+        auto first = std::lower_bound(entries.begin(), entries.end(), query, [](const InventoryEntry& a, uint64_t value) {
+            return a.milliohms < value;
+        });
+        for (; first != entries.end() && first->milliohms == query; first++) expected += first->quantity;
+    }
+    printf("check   %s\n", (total == expected) ? "ok" : "MISMATCH");
+    return total == expected;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 4 && strcmp(argv[1], "--bench") == 0) return runBench((size_t)atol(argv[2]), argv[3]) ? 0 : 1;
+
+    if (argc != 3 || argv[1][0] == '-') {
+        fprintf(stderr, "usage: inventory_build inventory.csv inventory.bin\n"
+                        "       inventory_build --bench N directory\n");
+        return 2;
+    }
+
+    std::vector<InventoryEntry> entries;
+    if (!loadCsv(argv[1], entries)) return 1;
+    if (!writeInventory(argv[2], entries)) {
+        fprintf(stderr, "inventory_build: cannot write '%s'\n", argv[2]);
+        return 1;
+    }
+    printf("%s: %zu entries\n", argv[2], entries.size());
+    return 0;
+}
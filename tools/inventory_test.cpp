@@ -0,0 +1,183 @@
+// Host test of the parts inventory log (inventory.h), built with the address and undefined behavior
+// sanitizers. A base file is written, stock changes are appended to the log (new and existing
+// values and locations, removals, truncated names), then the log is cut in the middle of its
+// last record as after a crash. Reopening must replay every whole record and drop the torn one,
+// a change appended after it must replay too, and compact() must fold the log into a base whose
+// lookups match a std::lower_bound search over the expected stock, also after reopening.
+//
+//   inventory_test directory [changes]
+//
+// Default 20000 logged changes. The directory must exist, its inventory files are replaced.
+
+#include "inventory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace resistor;
+
+// Expected stock per value and location, names as stored (truncated)
+using Stock = std::map<std::pair<uint64_t, std::string>, int64_t>;
+
+static std::string storedName(const std::string& location)
+{
+    return location.substr(0, inventoryLocationSize - 1);
+}
+
+// Checks quantity() and find() against a std::lower_bound search over the positive stock entries
+static bool checkLookups(const char* name, const Inventory& inventory, const Stock& stock, const std::vector<uint64_t>& queries)
+{
+    std::vector<InventoryEntry> entries;
+    for (const auto& item : stock) {
+        if (item.second > 0) entries.push_back({ item.first.first, (uint32_t)item.second, item.first.second });
+    }
+
+    for (uint64_t query : queries) {
+        auto first = std::lower_bound(entries.begin(), entries.end(), query, [](const InventoryEntry& a, uint64_t value) {
+            return a.milliohms < value;
+        });
+
+        uint32_t expected = 0;
+        std::vector<std::string> locations;
+        for (; first != entries.end() && first->milliohms == query; first++) {
+            expected += first->quantity;
+            locations.push_back(first->location);
+        }
+
+        InventoryMatch matches[64];
+        size_t count = inventory.find(query, matches, 64);
+        std::vector<std::string> found;
+        for (size_t i = 0; i < std::min<size_t>(count, 64); i++) found.push_back(matches[i].location);
+        std::sort(found.begin(), found.end());
+
+        if (inventory.quantity(query) != expected || found != locations) {
+            fprintf(stderr, "inventory_test: %s: %llu milliohms: %u in %zu locations, expected %u in %zu\n", name,
+                    (unsigned long long)query, inventory.quantity(query), count, expected, locations.size());
+            return false;
+        }
+    }
+
+    printf("check   %-40s %zu lookups: same as std::lower_bound\n", name, queries.size());
+    return true;
+}
+
+static long fileSize(const std::string& path)
+{
+    struct stat info;
+    return (stat(path.c_str(), &info) == 0) ? (long)info.st_size : -1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: inventory_test directory [changes]\n");
+        return 2;
+    }
+    const char* directory = argv[1];
+    size_t changes = (argc > 2) ? (size_t)atol(argv[2]) : 20000;
+    std::string basePath = std::string(directory) + "/" + inventoryFileName;
+    std::string logPath = std::string(directory) + "/" + inventoryLogFileName;
+    remove(logPath.c_str());
+
+    // Base: 2000 values in up to 3 of 50 bins each
+    std::mt19937_64 random(1);
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 2000; i++) values.push_back((random() % 1000000000ull + 1)*((random() % 2) ? 1000 : 1));
+    auto location = [&]() { return "Bin " + std::to_string(random() % 50); };
+
+    Stock stock;
+    std::vector<InventoryEntry> entries;
+    for (uint64_t value : values) {
+        for (int i = (int)(random() % 3) + 1; i > 0; i--) {
+            InventoryEntry entry = { value, (uint32_t)(random() % 100 + 1), location() };
+            stock[{ entry.milliohms, entry.location }] += entry.quantity;
+            entries.push_back(entry);
+        }
+    }
+    if (!writeInventory(basePath.c_str(), entries)) {
+        fprintf(stderr, "inventory_test: cannot write '%s'\n", basePath.c_str());
+        return 1;
+    }
+
+    // Queries: every base value, values only in the log, and values nowhere
+    std::vector<uint64_t> queries = values;
+    for (int i = 0; i < 200; i++) queries.push_back(random() % 1000000000000ull);
+
+    // Changes: mostly on base values and bins, some new values, removals and long bin names
+    Inventory inventory;
+    if (!inventory.open(directory)) {
+        fprintf(stderr, "inventory_test: cannot open '%s'\n", directory);
+        return 1;
+    }
+    Stock beforeLast;
+    for (size_t i = 0; i < changes; i++) {
+        uint64_t value = (random() % 8 == 0) ? random() % 1000000000000ull + 1 : values[random() % values.size()];
+        std::string name = (random() % 16 == 0) ? "Shelf " + std::to_string(random() % 4) + " with a name longer than a record" : location();
+        int32_t change = (int32_t)(random() % 61) - 40;
+
+        if (i + 1 == changes) beforeLast = stock;
+        if (!inventory.record(value, change, name.c_str())) {
+            fprintf(stderr, "inventory_test: cannot append to '%s'\n", logPath.c_str());
+            return 1;
+        }
+        stock[{ value, storedName(name) }] += change;
+        if (random() % 4 == 0) queries.push_back(value);
+    }
+    if (!checkLookups("base and log", inventory, stock, queries)) return 1;
+
+    // Crash in the middle of the last record: only the whole records are replayed
+    long logSize = fileSize(logPath);
+    if (logSize != (long)(changes*sizeof(InventoryDelta)) || truncate(logPath.c_str(), logSize - 17) != 0) {
+        fprintf(stderr, "inventory_test: log is %ld bytes, expected %zu\n", logSize, changes*sizeof(InventoryDelta));
+        return 1;
+    }
+    Inventory reopened;
+    if (!reopened.open(directory) || reopened.getDeltaCount() != changes - 1) {
+        fprintf(stderr, "inventory_test: reopen after a torn record: %zu changes, expected %zu\n", reopened.getDeltaCount(), changes - 1);
+        return 1;
+    }
+    stock = beforeLast;
+    if (!checkLookups("torn last record dropped", reopened, stock, queries)) return 1;
+
+    // A change appended after the torn record replays on the next open
+    uint64_t appended = values[0];
+    if (!reopened.record(appended, 7, "Bin after crash")) {
+        fprintf(stderr, "inventory_test: cannot append to '%s'\n", logPath.c_str());
+        return 1;
+    }
+    stock[{ appended, "Bin after crash" }] += 7;
+    Inventory afterCrash;
+    if (!afterCrash.open(directory) || afterCrash.getDeltaCount() != changes) {
+        fprintf(stderr, "inventory_test: append after a torn record: %zu changes replayed, expected %zu\n",
+                afterCrash.getDeltaCount(), changes);
+        return 1;
+    }
+    if (!checkLookups("append after the torn record", afterCrash, stock, queries)) return 1;
+
+    // Compaction: log folded into the base and emptied, same lookups before and after reopening
+    size_t positive = 0;
+    for (const auto& item : stock) positive += (item.second > 0) ? 1 : 0;
+    if (!afterCrash.compact() || afterCrash.getDeltaCount() != 0 || fileSize(logPath) != 0 || afterCrash.getRecordCount() != positive) {
+        fprintf(stderr, "inventory_test: compact: %zu records, %zu changes, log %ld bytes, expected %zu records and an empty log\n",
+                afterCrash.getRecordCount(), afterCrash.getDeltaCount(), fileSize(logPath), positive);
+        return 1;
+    }
+    if (!checkLookups("compacted", afterCrash, stock, queries)) return 1;
+
+    Inventory compacted;
+    if (!compacted.open(directory) || !checkLookups("compacted and reopened", compacted, stock, queries)) return 1;
+
+    remove(basePath.c_str());
+    remove(logPath.c_str());
+    return 0;
+}
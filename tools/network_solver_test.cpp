@@ -0,0 +1,223 @@
+// Host test of the series/parallel network synthesis solver (network_solver.h). For targets inside,
+// below and above the range of E12 over two decades, the top networks of 1 to 4 parts must have
+// the errors of an exhaustive enumeration of every network of that many parts, with 1 and 4
+// workers. Then times the pair table and a 4 part solve over E96 on every multiplier band.
+//
+//   network_solver_test [threads]
+//
+// Threads of the timed solve, default one per hardware thread. Exits non-zero on the first mismatch.
+
+#include "e_series.h"
+#include "network_solver.h"
+#include "work_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace resistor;
+
+constexpr size_t topCount = 5;
+
+static double combine(double a, double b, char op)
+{
+    return (op == NetworkSeries) ? a + b : a*b/(a + b);
+}
+
+// Top-N of the enumeration, copies with the same parts and value dropped like in the solver
+class ReferenceTop {
+private:
+    struct Entry {
+        double error;
+        double ohms;
+        std::array<double, maxNetworkParts> parts;  // Sorted, unused ones zero
+    };
+
+    std::vector<Entry> entries;
+    double target;
+
+public:
+    explicit ReferenceTop(double value) : target(value) {}
+
+    void insert(double ohms, std::array<double, maxNetworkParts> parts) {
+        double error = std::fabs(ohms - target)/target;
+        if (entries.size() == topCount && error >= entries.back().error) return;
+
+        std::sort(parts.begin(), parts.end());
+        for (const Entry& entry : entries) {
+            if (entry.parts == parts && std::fabs(entry.ohms - ohms) <= 1e-9*ohms) return;
+        }
+
+        Entry entry = { error, ohms, parts };
+        entries.insert(std::upper_bound(entries.begin(), entries.end(), entry,
+            [](const Entry& a, const Entry& b) { return a.error < b.error; }), entry);
+        if (entries.size() > topCount) entries.pop_back();
+    }
+
+    const std::vector<Entry>& get() const {
+        return entries;
+    }
+};
+
+// Every network of partCount parts: one part, a op b, r1 op (a op b), r1 op (r2 op (a op b)) and
+// (a op b) op (c op d), with every value and operator
+static ReferenceTop enumerate(const std::vector<double>& values, double target, uint8_t partCount)
+{
+    static const char ops[2] = { NetworkSeries, NetworkParallel };
+    ReferenceTop top(target);
+    size_t n = values.size();
+
+    for (size_t a = 0; a < n; a++) {
+        if (partCount == 1) top.insert(values[a], {{ values[a] }});
+        for (size_t b = a; b < n && partCount > 1; b++) {
+            for (char pairOp : ops) {
+                double pair = combine(values[a], values[b], pairOp);
+                if (partCount == 2) top.insert(pair, {{ values[a], values[b] }});
+
+                for (size_t r1 = 0; r1 < n && partCount > 2; r1++) {
+                    for (char op1 : ops) {
+                        if (partCount == 3) top.insert(combine(values[r1], pair, op1), {{ values[r1], values[a], values[b] }});
+                        if (partCount != 4) continue;
+
+                        for (size_t r2 = 0; r2 < n; r2++) {
+                            for (char op2 : ops) {
+                                top.insert(combine(values[r1], combine(values[r2], pair, op2), op1),
+                                           {{ values[r1], values[r2], values[a], values[b] }});
+                            }
+                        }
+
+                        // r1 is the first part of the second pair, its second part at or above r1
+                        for (size_t d = r1; d < n; d++) {
+                            for (char op2 : ops) {
+                                top.insert(combine(pair, combine(values[r1], values[d], op2), op1),
+                                           {{ values[a], values[b], values[r1], values[d] }});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return top;
+}
+
+// Value of a network from its postfix form
+static double evaluate(const Network& network)
+{
+    double stack[maxNetworkParts];
+    int depth = 0;
+    uint8_t part = 0;
+    for (int i = 0; i < network.partCount*2 - 1; i++) {
+        if (network.postfix[i] == NetworkPart) stack[depth++] = network.parts[part++];
+        else {
+            depth--;
+            stack[depth - 1] = combine(stack[depth - 1], stack[depth], network.postfix[i]);
+        }
+    }
+    return stack[0];
+}
+
+static bool checkTarget(const NetworkSolver& solver, const std::vector<double>& values, double target, unsigned workers)
+{
+    SynthesisResult result = solver.solve(target, maxNetworkParts, topCount);
+
+    for (uint8_t parts = 1; parts <= maxNetworkParts; parts++) {
+        ReferenceTop reference = enumerate(values, target, parts);
+        const std::vector<Network>& found = result.byParts[parts];
+        bool same = (found.size() == reference.get().size());
+
+        for (size_t i = 0; same && i < found.size(); i++) {
+            const Network& network = found[i];
+            bool partsListed = true;
+            for (uint8_t p = 0; p < parts; p++) partsListed &= std::binary_search(values.begin(), values.end(), network.parts[p]);
+
+            same = partsListed && (network.partCount == parts) &&
+                   (std::fabs(evaluate(network) - network.ohms) <= 1e-12*network.ohms) &&
+                   (std::fabs(std::fabs(network.error) - reference.get()[i].error) <= 1e-12);
+        }
+
+        if (!same) {
+            fprintf(stderr, "network_solver_test: %u workers, target %g, %u parts: solver and enumeration differ\n",
+                    workers, target, parts);
+            for (size_t i = 0; i < std::max(found.size(), reference.get().size()); i++) {
+                char text[128] = "";
+                if (i < found.size()) found[i].describe(text, sizeof(text));
+                fprintf(stderr, "    %-36s %.12f   enumeration %.12f\n", text, (i < found.size()) ? std::fabs(found[i].error) : NAN,
+                        (i < reference.get().size()) ? reference.get()[i].error : NAN);
+            }
+            return false;
+        }
+    }
+
+    // Overall list: fewer parts first on equal errors, so its best is the best of any part count
+    double best = INFINITY;
+    for (uint8_t parts = 1; parts <= maxNetworkParts; parts++) best = std::min(best, std::fabs(result.byParts[parts][0].error));
+    if (result.best.empty() || std::fabs(result.best[0].error) != best) {
+        fprintf(stderr, "network_solver_test: %u workers, target %g: overall best is not the best of every part count\n", workers, target);
+        return false;
+    }
+    return true;
+}
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    unsigned threads = (argc > 1) ? (unsigned)atoi(argv[1]) : 0;
+
+    // 10 to 820 ohms, targets below, inside (on a table value too) and above what 4 parts reach
+    std::vector<double> e12 = seriesValues(E12, 0, 1);
+    const double targets[] = { 2.5, 4.7, 47.3, 123.4, 270.0, 999.0, 1234.5, 3141.59, 10000.0 };
+
+    for (unsigned workers : { 1u, 4u }) {
+        WorkPool pool(workers);
+        NetworkSolver solver(e12, pool);
+        for (double target : targets) {
+            if (!checkTarget(solver, e12, target, workers)) return 1;
+        }
+        printf("check   E12 %zu values, %u workers, %zu targets: top %zu of 1 to 4 parts same as the enumeration\n",
+               e12.size(), workers, sizeof(targets)/sizeof(targets[0]), topCount);
+    }
+
+    // Table size limit: E192 on every band fits, one value more is refused
+    WorkPool pool(threads);
+    {
+        std::vector<double> e192 = seriesValues(E192);
+        std::vector<double> tooMany(NetworkSolver::maxValues + 1);
+        for (size_t i = 0; i < tooMany.size(); i++) tooMany[i] = 1.0 + (double)i;
+
+        NetworkSolver full(e192, pool);
+        NetworkSolver refused(tooMany, pool);
+        bool limit = (full.getPairCount() == e192.size()*(e192.size() + 1)) && (refused.getValueCount() == 0) &&
+                     refused.solve(1000.0, maxNetworkParts, topCount).best.empty();
+        printf("check   %zu values accepted (%zu pairs), %zu refused: %s\n", e192.size(), full.getPairCount(), tooMany.size(),
+               limit ? "ok" : "MISMATCH");
+        if (!limit) return 1;
+    }
+
+    // E96 on every band, best of 3 solves
+    std::vector<double> e96 = seriesValues(E96);
+    auto start = std::chrono::steady_clock::now();
+    NetworkSolver solver(e96, pool);
+    double buildTime = elapsedMilliseconds(start);
+
+    double solveTime = 1e30;
+    SynthesisResult result;
+    for (int run = 0; run < 3; run++) {
+        start = std::chrono::steady_clock::now();
+        result = solver.solve(12345.6, maxNetworkParts, 10);
+        solveTime = std::min(solveTime, elapsedMilliseconds(start));
+    }
+
+    char text[128] = "";
+    result.best[0].describe(text, sizeof(text));
+    printf("solve   E96 %zu values, %zu pairs: %.1f ms pair table, 4 parts %.1f ms with %u workers (12345.6: %s, %+.2g)\n",
+           e96.size(), solver.getPairCount(), buildTime, solveTime, pool.getWorkerCount(), text, result.best[0].error);
+    return 0;
+}
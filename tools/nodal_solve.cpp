@@ -0,0 +1,288 @@
+// Equivalent resistance of resistor netlists, and a benchmark of the sparse nodal solver
+// (nodal_solver.h) against dense Gaussian elimination, host side.
+//
+//   nodal_solve [--threads N] netlist a b [a b ...]
+//   nodal_solve [--threads N] --bench      (exit status 1 when a check fails)
+//
+// Netlist lines are "name node node marking", nodes are integers and the value is an SMD marking
+// decoded by smd_decode.h ("472", "4R7", "01C", "0" for a jumper). Lines starting with '*' or
+// '#' are comments.
+
+#include "band_layout.h"
+#include "e_series.h"
+#include "nodal_solver.h"
+#include "smd_decode.h"
+#include "work_pool.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace resistor;
+
+struct Options {
+    unsigned threads;
+    bool bench;
+    std::vector<const char*> positional;
+};
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool loadNetlist(const char* fileName, ResistorMesh& mesh)
+{
+    FILE* file = fopen(fileName, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "nodal_solve: cannot open netlist '%s'\n", fileName);
+        return false;
+    }
+
+    char line[256];
+    int lineNumber = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        lineNumber++;
+        if (line[0] == '*' || line[0] == '#' || line[0] == '\n') continue;
+
+        char name[64], marking[16];
+        unsigned a, b;
+        if (sscanf(line, "%63s %u %u %15s", name, &a, &b, marking) != 4) {
+            fprintf(stderr, "nodal_solve: %s:%d: expected \"name node node marking\"\n", fileName, lineNumber);
+            ok = false;
+            continue;
+        }
+
+        SmdDecode value = decodeSmd(marking, strlen(marking));
+        if (value.kind == SmdInvalid) {
+            fprintf(stderr, "nodal_solve: %s:%d: unknown marking '%s'\n", fileName, lineNumber, marking);
+            ok = false;
+            continue;
+        }
+        mesh.add(a, b, value.milliohms);
+    }
+    fclose(file);
+    return ok;
+}
+
+//----------------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------------
+
+// side x side grid of E24 values between 100 and 100k, node = y*side + x
+static ResistorMesh makeGrid(uint32_t side, uint32_t seed)
+{
+    std::vector<double> values = seriesValues(E24, 2, 4);
+    std::mt19937 random(seed);
+
+    ResistorMesh mesh(side*side);
+    for (uint32_t y = 0; y < side; y++) {
+        for (uint32_t x = 0; x < side; x++) {
+            uint32_t node = y*side + x;
+            if (x + 1 < side) mesh.add(node, node + 1, (uint64_t)(values[random() % values.size()]*1000.0));
+            if (y + 1 < side) mesh.add(node, node + side, (uint64_t)(values[random() % values.size()]*1000.0));
+        }
+    }
+    return mesh;
+}
+
+// Reference: dense conductance matrix with node 0 as reference, Cholesky, one solve per port
+class DenseSolver {
+private:
+    size_t size;
+    std::vector<double> matrix;
+
+public:
+    explicit DenseSolver(const ResistorMesh& mesh) : size(mesh.getNodeCount() - 1), matrix(size*size, 0.0) {
+        for (const MeshResistor& resistor : mesh.getResistors()) {
+            double conductance = 1000.0/(double)resistor.milliohms;
+            long a = (long)resistor.a - 1;
+            long b = (long)resistor.b - 1;
+            if (a >= 0) matrix[a*size + a] += conductance;
+            if (b >= 0) matrix[b*size + b] += conductance;
+            if (a >= 0 && b >= 0) {
+                matrix[a*size + b] -= conductance;
+                matrix[b*size + a] -= conductance;
+            }
+        }
+
+        // Gaussian elimination of a symmetric positive definite matrix, kept as L in the lower half
+        for (size_t k = 0; k < size; k++) {
+            double* rowK = &matrix[k*size];
+            for (size_t j = 0; j < k; j++) rowK[k] -= rowK[j]*rowK[j];
+            rowK[k] = std::sqrt(rowK[k]);
+            for (size_t i = k + 1; i < size; i++) {
+                double* rowI = &matrix[i*size];
+                double sum = rowI[k];
+                for (size_t j = 0; j < k; j++) sum -= rowI[j]*rowK[j];
+                rowI[k] = sum/rowK[k];
+            }
+        }
+    }
+
+    double resistance(uint32_t a, uint32_t b) const {
+        std::vector<double> x(size, 0.0);
+        if (a > 0) x[a - 1] += 1.0;
+        if (b > 0) x[b - 1] -= 1.0;
+        for (size_t i = 0; i < size; i++) {
+            for (size_t j = 0; j < i; j++) x[i] -= matrix[i*size + j]*x[j];
+            x[i] /= matrix[i*size + i];
+        }
+        for (size_t i = size; i-- > 0;) {
+            for (size_t j = i + 1; j < size; j++) x[i] -= matrix[j*size + i]*x[j];
+            x[i] /= matrix[i*size + i];
+        }
+        return ((a > 0) ? x[a - 1] : 0.0) - ((b > 0) ? x[b - 1] : 0.0);
+    }
+};
+
+static bool runBench(WorkPool& pool)
+{
+    bool ok = true;
+    NodalSolver solver(pool);
+
+    // Closed forms: balanced bridge, 16 bit R-2R ladder (R seen from its input)
+    ResistorMesh bridge(4);
+    bridge.add(0, 1, 1000000);
+    bridge.add(0, 2, 2000000);
+    bridge.add(1, 3, 1000000);
+    bridge.add(2, 3, 2000000);
+    bridge.add(1, 2, 4700000);
+    solver.factor(bridge);
+    double bridgeOhms = solver.resistance(0, 3);
+    printf("bridge       %.9g ohms (expected 1333.33, no current through the balanced bridge)\n", bridgeOhms);
+    ok &= std::fabs(bridgeOhms - 4000.0/3.0) < 1e-6;
+
+    ResistorMesh ladder;
+    constexpr uint32_t bits = 16;
+    for (uint32_t bit = 0; bit < bits; bit++) {
+        ladder.add(bit + 1, 0, 20000000);                               // 2R to ground
+        if (bit + 1 < bits) ladder.add(bit + 1, bit + 2, 10000000);    // R along the ladder
+    }
+    ladder.add(bits, 0, 20000000);                                      // Termination
+    solver.factor(ladder);
+    double ladderOhms = solver.resistance(1, 0);
+    printf("R-2R ladder  %.9g ohms (expected 10000)\n", ladderOhms);
+    ok &= std::fabs(ladderOhms - 10000.0) < 1e-6;
+
+    // Sparse against dense on the same random grid
+    constexpr uint32_t denseSide = 40;
+    ResistorMesh grid = makeGrid(denseSide, 1);
+    std::vector<std::pair<uint32_t, uint32_t>> ports;
+    std::mt19937 random(2);
+    for (int i = 0; i < 16; i++) ports.push_back({ (uint32_t)(random() % grid.getNodeCount()), (uint32_t)(random() % grid.getNodeCount()) });
+
+    auto start = std::chrono::steady_clock::now();
+    DenseSolver dense(grid);
+    double denseFactor = elapsedMilliseconds(start);
+    start = std::chrono::steady_clock::now();
+    std::vector<double> denseResults;
+    for (const auto& port : ports) denseResults.push_back(dense.resistance(port.first, port.second));
+    double denseSolve = elapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    solver.factor(grid);
+    double sparseFactor = elapsedMilliseconds(start);
+    start = std::chrono::steady_clock::now();
+    std::vector<double> sparseResults(ports.size());
+    solver.resistanceBatch(ports.data(), sparseResults.data(), ports.size());
+    double sparseSolve = elapsedMilliseconds(start);
+
+    double worst = 0.0;
+    for (size_t i = 0; i < ports.size(); i++) {
+        if (ports[i].first == ports[i].second) continue;
+        worst = std::max(worst, std::fabs(sparseResults[i] - denseResults[i])/denseResults[i]);
+    }
+    printf("grid %ux%u   dense: %.1f ms factor, %.2f ms for %zu ports\n", denseSide, denseSide, denseFactor, denseSolve, ports.size());
+    printf("             sparse: %.2f ms factor, %.2f ms for %zu ports, worst relative difference %.2g\n",
+           sparseFactor, sparseSolve, ports.size(), worst);
+    ok &= worst < 1e-8;
+
+    // 100k nodes, sparse only
+    constexpr uint32_t largeSide = 317;
+    grid = makeGrid(largeSide, 3);
+    start = std::chrono::steady_clock::now();
+    solver.factor(grid);
+    double largeFactor = elapsedMilliseconds(start);
+
+    uint32_t center = (largeSide/2)*largeSide + largeSide/2;
+    start = std::chrono::steady_clock::now();
+    double corners = solver.resistance(0, largeSide*largeSide - 1);
+    double largeSolve = elapsedMilliseconds(start);
+    double neighbours = solver.resistance(center, center + 1);
+    printf("grid %ux%u %u rows, %zu entries, %zu in the factor: %.1f ms factor, %.1f ms per port\n",
+           largeSide, largeSide, solver.getRowCount(), solver.getEntryCount(), solver.getFactorEntryCount(), largeFactor, largeSolve);
+    printf("             corners %.6g ohms, center neighbours %.6g ohms\n", corners, neighbours);
+    ok &= std::isfinite(corners) && corners > 0.0;
+
+    // 100k separate dividers of two resistors, one part each: the ordering must not recurse per part
+    constexpr uint32_t dividers = 100000;
+    ResistorMesh parts(3*dividers);
+    for (uint32_t i = 0; i < dividers; i++) {
+        parts.add(3*i, 3*i + 1, 1000000);
+        parts.add(3*i + 1, 3*i + 2, 2200000);
+    }
+    start = std::chrono::steady_clock::now();
+    solver.factor(parts);
+    double partsFactor = elapsedMilliseconds(start);
+    double divider = solver.resistance(3*(dividers - 1), 3*(dividers - 1) + 2);
+    double across = solver.resistance(0, 3*(dividers - 1));
+    printf("%u dividers %u rows: %.1f ms factor, last one %.6g ohms (expected 3200), across dividers %g\n",
+           dividers, solver.getRowCount(), partsFactor, divider, across);
+    ok &= std::fabs(divider - 3200.0) < 1e-6 && std::isinf(across);
+
+    return ok;
+}
+
+static bool parseOptions(int argc, char** argv, Options& options)
+{
+    options = { 0, false, {} };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) options.threads = (unsigned)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--bench") == 0) options.bench = true;
+        else if (argv[i][0] == '-' && argv[i][1] == '-') return false;
+        else options.positional.push_back(argv[i]);
+    }
+
+    if (options.bench) return options.positional.empty();
+    return options.positional.size() >= 3 && options.positional.size()%2 == 1;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: nodal_solve [--threads N] netlist a b [a b ...]\n"
+                        "       nodal_solve [--threads N] --bench\n");
+        return 2;
+    }
+
+    WorkPool pool(options.threads);
+    if (options.bench) return runBench(pool) ? 0 : 1;
+
+    ResistorMesh mesh;
+    if (!loadNetlist(options.positional[0], mesh)) return 1;
+
+    NodalSolver solver(pool);
+    solver.factor(mesh);
+
+    std::vector<std::pair<uint32_t, uint32_t>> ports;
+    for (size_t i = 1; i + 1 < options.positional.size(); i += 2)
+        ports.push_back({ (uint32_t)atoi(options.positional[i]), (uint32_t)atoi(options.positional[i + 1]) });
+
+    std::vector<double> results(ports.size());
+    solver.resistanceBatch(ports.data(), results.data(), ports.size());
+
+    for (size_t i = 0; i < ports.size(); i++) {
+        char text[16] = "open";
+        if (std::isfinite(results[i])) formatMilliohms((uint64_t)std::llround(results[i]*1000.0), text);
+        printf("%u %u: %s (%.9g ohms)\n", ports[i].first, ports[i].second, text, results[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Rounded rectangle tessellation benchmark of raylib's rshapes.c, host side. Draws the calculator's
+// rounded rectangles (panel, resistor body and outline, screen, 10 buttons) with automatic segment
+// counts, as main.cpp does without SDF shapes, and reports vertices per second.
+//
+//   rounded_rect_bench [frames]
+//   rounded_rect_bench_uncached [frames]
+//
+// Both are built from this file, with and without SUPPORT_ROUNDED_RECT_CACHE. rlgl is replaced by
+// the vertex copy below, so the timings are rshapes' own work plus the batch writes. Both print a
+// checksum of the vertex positions rounded to 1/64 pixel, they must match.
+
+#include "raylib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(SUPPORT_ROUNDED_RECT_CACHE)
+constexpr const char* variant = "cached";
+#else
+constexpr const char* variant = "uncached";
+#endif
+
+// Stand-in for the rlgl default batch: every vertex is written with the current texcoord and color
+constexpr int batchVertices = 8192;
+
+struct BatchVertex {
+    float x, y, z;
+    float u, v;
+    uint8_t color[4];
+};
+
+static BatchVertex batch[batchVertices];
+static int batchCount = 0;
+static float texcoord[2] = { 0 };
+static uint8_t color[4] = { 0 };
+
+static uint64_t vertexCount = 0;
+static uint64_t checksum = 0;
+static bool hashing = false;
+
+extern "C" {
+void rlBegin(int) {}
+void rlEnd(void) {}
+void rlSetTexture(unsigned int) {}
+void rlNormal3f(float, float, float) {}
+
+void rlTexCoord2f(float x, float y)
+{
+    texcoord[0] = x;
+    texcoord[1] = y;
+}
+
+void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+    color[3] = a;
+}
+
+void rlVertex2f(float x, float y)
+{
+    BatchVertex& vertex = batch[batchCount];
+    vertex = { x, y, 0.0f, texcoord[0], texcoord[1], { color[0], color[1], color[2], color[3] } };
+    batchCount = (batchCount + 1)%batchVertices;
+    vertexCount++;
+
+    if (hashing) {
+        uint64_t position = ((uint64_t)(uint32_t)std::lround(x*64.0f) << 32) | (uint32_t)std::lround(y*64.0f);
+        checksum = (checksum ^ position)*0x100000001b3ull;
+    }
+}
+}
+
+// One frame of main.cpp's rounded rectangles, button 4 pressed
+static void drawFrame()
+{
+    const Rectangle panel = { 10, 0, 700, 1280 };
+    const Rectangle resistorBody = { 80, 75, 560, 250 };
+    const Rectangle screen = { 275, 400, 375, 200 };
+
+    DrawRectangleRounded(panel, 0.15f, 0, WHITE);
+    DrawRectangleRoundedLinesEx(resistorBody, 0.15f, 0, 20, WHITE);
+    DrawRectangleRounded(resistorBody, 0.15f, 0, WHITE);
+    DrawRectangleRounded(screen, 0.25f, 0, WHITE);
+
+    for (int i = 0; i < 10; i++) {
+        float shrink = (i == 4) ? 10.0f : 0.0f;
+        Rectangle button = { 100.0f + 200*(i%3) + shrink/2, 650.0f + 200*(i/3) + shrink/2, 120 - shrink, 120 - shrink };
+        if (i == 9) button = (Rectangle){ 100, 450, 120, 120 };
+        DrawRectangleRounded(button, 1.0f, 0, WHITE);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    hashing = true;
+    drawFrame();
+    hashing = false;
+    uint64_t frameVertices = vertexCount;
+
+    // Best of 3 runs
+    double best = 1e30;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) drawFrame();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    printf("%-8s  %llu vertices per frame, %.1f us per frame, %.1f M vertices/s  (checksum %016llx)\n", variant,
+           (unsigned long long)frameVertices, best*1e6/frames, (double)frameVertices*frames/best/1e6, (unsigned long long)checksum);
+    return 0;
+}
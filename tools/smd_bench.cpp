@@ -0,0 +1,84 @@
+// SMD marking decode benchmark (smd_decode.h), host side. Decodes a mix of 3-digit, 4-digit,
+// R-notation and EIA-96 markings, plus unreadable ones, with decodeSmdBatch() and one
+// decodeSmd() call per code, single threaded, and reports codes per second.
+//
+//   smd_bench [codes]
+//
+// Default 10 million codes, stored back to back 4 bytes each as decodeSmdBatch() expects.
+
+#include "smd_decode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace resistor;
+
+constexpr size_t stride = smdMaxLength;
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// One marking of a random kind, NUL padded to the stride
+static void randomMarking(std::mt19937& random, char* code)
+{
+    static const char letters[] = "ZYXSABHCDEF";
+    memset(code, 0, stride);
+
+    switch (random()%5) {
+        case 0: snprintf(code, stride + 1, "%02u%u", (unsigned)(random()%100), (unsigned)(random()%7)); break;
+        case 1: snprintf(code, stride + 1, "%03u%u", (unsigned)(random()%1000), (unsigned)(random()%7)); break;
+        case 2: {
+            unsigned digits = (unsigned)(random()%1000);
+            size_t mark = random()%3;
+            char text[8];
+            snprintf(text, sizeof(text), "%03u", digits);
+            memcpy(code, text, mark);
+            code[mark] = 'R';
+            memcpy(code + mark + 1, text + mark, 3 - mark);
+        } break;
+        case 3: snprintf(code, stride + 1, "%02u%c", (unsigned)(1 + random()%96), letters[random()%11]); break;
+        default: for (size_t i = 0; i < stride; i++) code[i] = (char)(' ' + random()%95); break;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? (size_t)atol(argv[1]) : 10000000;
+    if (count == 0) count = 1;
+
+    std::mt19937 random(1);
+    std::vector<char> codes(count*stride);
+    for (size_t i = 0; i < count; i++) randomMarking(random, &codes[i*stride]);
+
+    std::vector<SmdDecode> results(count);
+    decodeSmdBatch(codes.data(), stride, results.data(), count);
+    size_t kinds[SmdEia96 + 1] = { 0 };
+    for (const SmdDecode& result : results) kinds[result.kind]++;
+
+    // Best of 3 runs each
+    double batch = 1e30, single = 1e30;
+    uint64_t sum = 0;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        decodeSmdBatch(codes.data(), stride, results.data(), count);
+        batch = std::min(batch, elapsedSeconds(start));
+        for (size_t i = 0; i < count; i += 4096) sum += results[i].milliohms;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) sum += decodeSmd(&codes[i*stride], stride).milliohms;
+        single = std::min(single, elapsedSeconds(start));
+    }
+
+    printf("codes   %zu: %zu 3-digit, %zu 4-digit, %zu R-notation, %zu EIA-96, %zu jumpers, %zu invalid\n", count,
+           kinds[SmdThreeDigit], kinds[SmdFourDigit], kinds[SmdRNotation], kinds[SmdEia96], kinds[SmdJumper], kinds[SmdInvalid]);
+    printf("decode  batch %.1f M codes/s, decodeSmd() %.1f M codes/s  (%llu)\n", count/batch/1e6, count/single/1e6,
+           (unsigned long long)sum);
+    return 0;
+}
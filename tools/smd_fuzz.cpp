@@ -0,0 +1,172 @@
+// Fuzz target of the SMD marking decoder (smd_decode.h), host side. Every input is decoded with
+// decodeSmd() and with the plain string parser below, written from the marking rules without the
+// class table. Both must agree, and decodeSmdBatch() must agree with decodeSmd().
+//
+//   smd_fuzz [inputs]           built-in driver: every code up to 3 characters over the marking
+//                               alphabet, then random codes up to 6 bytes (default 10 million)
+//
+// With clang, configuring with -DSMD_FUZZ_LIBFUZZER=ON links LLVMFuzzerTestOneInput() below into
+// libFuzzer instead of the built-in driver. Both builds use the address and undefined behavior
+// sanitizers. Aborts on the first mismatch.
+
+#include "smd_decode.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+using namespace resistor;
+
+// E96 significands, written out rather than taken from e_series.h
+static const uint16_t e96[96] = {
+    100, 102, 105, 107, 110, 113, 115, 118, 121, 124, 127, 130, 133, 137, 140, 143,
+    147, 150, 154, 158, 162, 165, 169, 174, 178, 182, 187, 191, 196, 200, 205, 210,
+    215, 221, 226, 232, 237, 243, 249, 255, 261, 267, 274, 280, 287, 294, 301, 309,
+    316, 324, 332, 340, 348, 357, 365, 374, 383, 392, 402, 412, 422, 432, 442, 453,
+    464, 475, 487, 499, 511, 523, 536, 549, 562, 576, 590, 604, 619, 634, 649, 665,
+    681, 698, 715, 732, 750, 768, 787, 806, 825, 845, 866, 887, 909, 931, 953, 976
+};
+
+static bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static uint64_t power10(int exponent)
+{
+    uint64_t result = 1;
+    while (exponent-- > 0) result *= 10;
+    return result;
+}
+
+// EIA-96 multiplier letter in milliohms, 0 when not a multiplier letter
+static uint64_t eia96Scale(char letter)
+{
+    switch (letter | 0x20) {
+        case 'z': return 1;
+        case 'y': return 10;
+        case 'x': case 's': return 100;
+        case 'a': return 1000;
+        case 'b': case 'h': return 10000;
+        case 'c': return 100000;
+        case 'd': return 1000000;
+        case 'e': return 10000000;
+        case 'f': return 100000000;
+        default: return 0;
+    }
+}
+
+static SmdDecode referenceDecode(const char* data, size_t size)
+{
+    std::string code(data, strnlen(data, size));
+    SmdDecode result = {};
+    if (code.empty() || code.size() > smdMaxLength) return result;
+
+    size_t digitCount = 0, decimalCount = 0;
+    for (char c : code) {
+        digitCount += isDigit(c);
+        decimalCount += (c == 'R' || c == 'r');
+    }
+
+    if (digitCount == code.size()) {
+        uint64_t value = std::stoull(code);
+        if (value == 0) result.kind = SmdJumper;
+        else if (code.size() == 3 || code.size() == 4) {
+            result.kind = (code.size() == 3) ? SmdThreeDigit : SmdFourDigit;
+            result.milliohms = std::stoull(code.substr(0, code.size() - 1))*power10(code.back() - '0' + 3);
+            result.tolerance = (code.size() == 3) ? 500 : 100;
+        }
+        return result;
+    }
+
+    // A lone R is no value
+    if (decimalCount == 1 && digitCount + 1 == code.size() && code.size() >= 2) {
+        size_t mark = code.find_first_of("Rr");
+        std::string whole = code.substr(0, mark), decimals = code.substr(mark + 1);
+        result.kind = SmdRNotation;
+        result.milliohms = (whole.empty() ? 0 : std::stoull(whole))*1000 +
+                           (decimals.empty() ? 0 : std::stoull(decimals)*power10(3 - (int)decimals.size()));
+        return result;
+    }
+
+    if (code.size() == 3 && isDigit(code[0]) && isDigit(code[1]) && eia96Scale(code[2]) != 0) {
+        int index = std::stoi(code.substr(0, 2));
+        if (index < 1 || index > 96) return result;
+        result.kind = SmdEia96;
+        result.milliohms = e96[index - 1]*eia96Scale(code[2]);
+        result.tolerance = 100;
+    }
+    return result;
+}
+
+static void check(const uint8_t* data, size_t size)
+{
+    const char* text = (const char*)data;
+    SmdDecode decoded = decodeSmd(text, size);
+    SmdDecode expected = referenceDecode(text, size);
+
+    if (decoded.kind != expected.kind || decoded.milliohms != expected.milliohms || decoded.tolerance != expected.tolerance) {
+        fprintf(stderr, "smd_fuzz: \"%.*s\" (%zu bytes): kind %u, %llu milliohms, tolerance %u, expected kind %u, %llu, %u\n",
+                (int)size, text, size, decoded.kind, (unsigned long long)decoded.milliohms, decoded.tolerance,
+                expected.kind, (unsigned long long)expected.milliohms, expected.tolerance);
+        abort();
+    }
+
+    // Same code through the batch API, as the second code of a batch of two
+    if (size > 0 && size <= 8) {
+        char codes[16] = {};
+        memcpy(codes + size, text, size);
+        SmdDecode batch[2];
+        decodeSmdBatch(codes, size, batch, 2);
+        if (batch[1].kind != decoded.kind || batch[1].milliohms != decoded.milliohms) {
+            fprintf(stderr, "smd_fuzz: \"%.*s\": decodeSmdBatch() differs from decodeSmd()\n", (int)size, text);
+            abort();
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    check(data, size);
+    return 0;
+}
+
+#if !defined(SMD_FUZZ_LIBFUZZER)
+int main(int argc, char** argv)
+{
+    size_t inputs = (argc > 1) ? (size_t)atol(argv[1]) : 10000000;
+
+    // Marking characters, both cases, the NUL terminator and a few characters that are never valid
+    static const char alphabet[] = "0123456789RrZzYyXxSsAaBbHhCcDdEeFf\0G. \xff";
+    constexpr size_t alphabetSize = sizeof(alphabet) - 1;
+
+    uint8_t code[8];
+    size_t exhaustive = 0;
+    for (size_t length = 0; length <= 3; length++) {
+        size_t combinations = 1;
+        for (size_t i = 0; i < length; i++) combinations *= alphabetSize;
+        for (size_t n = 0; n < combinations; n++) {
+            size_t rest = n;
+            for (size_t i = 0; i < length; i++, rest /= alphabetSize) code[i] = (uint8_t)alphabet[rest%alphabetSize];
+            check(code, length);
+            exhaustive++;
+        }
+    }
+
+    // Mostly marking characters, one byte in 16 anything
+    std::mt19937 random(1);
+    for (size_t n = 0; n < inputs; n++) {
+        size_t length = random()%7;
+        for (size_t i = 0; i < length; i++) {
+            uint32_t pick = random();
+            code[i] = ((pick & 0xf) == 0) ? (uint8_t)(pick >> 8) : (uint8_t)alphabet[(pick >> 8)%alphabetSize];
+        }
+        check(code, length);
+    }
+
+    printf("fuzz    %zu exhaustive and %zu random codes: same as the reference parser\n", exhaustive, inputs);
+    return 0;
+}
+#endif
@@ -0,0 +1,136 @@
+// Host test of the Monte Carlo tolerance analysis (tolerance_analysis.h). Results must be bit for
+// bit the same with 1, 3 and 4 workers, sigma and yield must match their analytic values for
+// series networks (exact) and a divider (first order), uniform and gaussian, and no gaussian
+// sample may be pinned to the nominal value when the sample count is odd. Then times 1e6 samples.
+//
+//   tolerance_analysis_test [threads]
+//
+// Threads of the timed analysis, default one per hardware thread. Exits non-zero on the first failure.
+
+#include "tolerance_analysis.h"
+
+#define RPRAND_IMPLEMENTATION
+#include "external/rprand.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+
+using namespace resistor;
+
+static Network makeNetwork(std::initializer_list<double> parts, const char* postfix)
+{
+    Network network = {};
+    for (double part : parts) network.parts[network.partCount++] = part;
+    for (size_t i = 0; postfix[i] != '\0'; i++) network.postfix[i] = postfix[i];
+    return network;
+}
+
+static AnalysisSpec makeSpec(uint64_t samples, double specMin, double specMax, ToleranceDistribution distribution)
+{
+    return (AnalysisSpec){ samples, 12345, specMin, specMax, 64, 0.0, 0.0, distribution };
+}
+
+static bool sameResult(const AnalysisResult& a, const AnalysisResult& b)
+{
+    return a.nominal == b.nominal && a.mean == b.mean && a.sigma == b.sigma && a.minimum == b.minimum &&
+           a.maximum == b.maximum && a.yield == b.yield && a.histogram == b.histogram;
+}
+
+static bool checkClose(const char* name, double value, double expected, double relative)
+{
+    bool close = std::fabs(value - expected) <= relative*std::fabs(expected);
+    printf("check   %-42s %.6g, expected %.6g: %s\n", name, value, expected, close ? "ok" : "MISMATCH");
+    return close;
+}
+
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    unsigned threads = (argc > 1) ? (unsigned)atoi(argv[1]) : 0;
+    bool ok = true;
+
+    // 1k + 2.2k, 5% each, and a 1k over 2.2k divider at E96 (1%) loaded with 10k
+    Network series = makeNetwork({ 1000.0, 2200.0 }, "RR+");
+    const std::array<float, maxNetworkParts> tolerances = {{ 5.0f, 5.0f }};
+    Divider divider = {};
+    divider.top.ohms = 1000;
+    divider.bottom.ohms = 2200;
+    const double load = 10000.0;
+
+    // Same results for any worker count, over an odd number of samples and several tasks
+    {
+        AnalysisSpec spec = makeSpec(3*ToleranceAnalyzer::taskSamples + 101, 3100.0, 3300.0, GaussianTolerance);
+        WorkPool one(1), three(3), four(4);
+        AnalysisResult reference = ToleranceAnalyzer(one).analyze(series, tolerances, spec);
+        bool same = sameResult(reference, ToleranceAnalyzer(three).analyze(series, tolerances, spec)) &&
+                    sameResult(reference, ToleranceAnalyzer(four).analyze(series, tolerances, spec));
+        uint64_t binned = std::accumulate(reference.histogram.begin(), reference.histogram.end(), (uint64_t)0);
+        same &= (binned == spec.samples);
+        printf("check   %-42s %s\n", "1, 3 and 4 workers", same ? "identical" : "MISMATCH");
+        ok &= same;
+    }
+
+    WorkPool pool(threads);
+    ToleranceAnalyzer analyzer(pool);
+    constexpr uint64_t samples = 1000000;
+
+    // Series: sigma of a sum is exact, uniform +-t has sigma t/sqrt(3), gaussian t/3
+    double spreadSquares = std::pow(1000.0*0.05, 2) + std::pow(2200.0*0.05, 2);
+    AnalysisResult uniform = analyzer.analyze(series, tolerances, makeSpec(samples, 3200.0 - 50.0, 3200.0 + 50.0, UniformTolerance));
+    AnalysisResult gaussian = analyzer.analyze(series, tolerances, makeSpec(samples, 0.0, 0.0, GaussianTolerance));
+    ok &= checkClose("series uniform sigma", uniform.sigma, std::sqrt(spreadSquares/3.0), 0.01);
+    ok &= checkClose("series uniform mean", uniform.mean, 3200.0, 0.001);
+    ok &= checkClose("series gaussian sigma", gaussian.sigma, std::sqrt(spreadSquares)/3.0, 0.01);
+
+    // Yield of a single 1k 5% part: uniform within +-1% is 0.2, gaussian within +-1 sigma is 0.6827
+    Network single = makeNetwork({ 1000.0 }, "R");
+    AnalysisResult uniformYield = analyzer.analyze(single, tolerances, makeSpec(samples, 990.0, 1010.0, UniformTolerance));
+    AnalysisResult gaussianYield = analyzer.analyze(single, tolerances, makeSpec(samples, 1000.0 - 50.0/3.0, 1000.0 + 50.0/3.0, GaussianTolerance));
+    ok &= checkClose("single uniform yield within 1%", uniformYield.yield, 0.2, 0.01);
+    ok &= checkClose("single gaussian yield within 1 sigma", gaussianYield.yield, std::erf(1.0/std::sqrt(2.0)), 0.01);
+
+    // Divider: first order sensitivities of lower/(top + lower), lower = bottom || load
+    double lower = 2200.0*load/(2200.0 + load);
+    double ratio = lower/(1000.0 + lower);
+    double lowerPerBottom = std::pow(load/(2200.0 + load), 2);
+    double sensitivityTop = lower/std::pow(1000.0 + lower, 2)*1000.0;
+    double sensitivityBottom = 1000.0/std::pow(1000.0 + lower, 2)*lowerPerBottom*2200.0;
+    double dividerSigma = std::sqrt(std::pow(sensitivityTop, 2) + std::pow(sensitivityBottom, 2))*0.01/3.0;
+    AnalysisResult dividerResult = analyzer.analyze(divider, E96, load, makeSpec(samples, 0.0, 1.0, GaussianTolerance));
+    ok &= checkClose("divider nominal", dividerResult.nominal, ratio, 1e-12);
+    ok &= checkClose("divider gaussian sigma", dividerResult.sigma, dividerSigma, 0.02);
+
+    // Odd sample counts: every sample is drawn, none sits exactly on the nominal value
+    uint32_t pinned = 0;
+    for (uint64_t count : { 1, 3, 255, 257 }) {
+        for (uint64_t seed = 0; seed < 64; seed++) {
+            AnalysisSpec spec = makeSpec(count, 1000.0, 1000.0, GaussianTolerance);
+            spec.seed = seed;
+            pinned += (analyzer.analyze(single, tolerances, spec).yield > 0.0) ? 1 : 0;
+        }
+    }
+    printf("check   %-42s %u analyses with a sample on the nominal value: %s\n", "odd gaussian sample counts", pinned,
+           (pinned == 0) ? "ok" : "MISMATCH");
+    ok &= (pinned == 0);
+
+    // 1e6 samples of the two part network, best of 3 runs each
+    double times[2] = { 1e30, 1e30 };
+    for (int run = 0; run < 3; run++) {
+        for (int distribution = 0; distribution < 2; distribution++) {
+            auto start = std::chrono::steady_clock::now();
+            analyzer.analyze(series, tolerances, makeSpec(samples, 3100.0, 3300.0, (ToleranceDistribution)distribution));
+            times[distribution] = std::min(times[distribution], elapsedMilliseconds(start));
+        }
+    }
+    printf("sample  %llu samples of 1k + 2.2k with %u workers: uniform %.1f ms, gaussian %.1f ms\n",
+           (unsigned long long)samples, pool.getWorkerCount(), times[0], times[1]);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+// Headless test of the widget hit-test grid (widget_grid.h), host side. Hit tests on the
+// calculator layout, on random overlapping layouts past 256 widgets and 65535 cell entries, and
+// on the capacity limit must agree with a linear scan. Then times hit tests as the widget count
+// grows on a fixed cell size, against the linear scan.
+//
+//   widget_grid_test [hits]
+//
+// Default 1 million timed hit tests per layout. Exits non-zero on the first mismatch.
+
+#include "widget_grid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// First registered widget containing the point, what the grid must return
+static int linearHitTest(const std::vector<Rectangle>& widgets, Vector2 point)
+{
+    for (size_t id = 0; id < widgets.size(); id++) {
+        const Rectangle& rec = widgets[id];
+        if (point.x >= rec.x && point.x < rec.x + rec.width && point.y >= rec.y && point.y < rec.y + rec.height) return (int)id;
+    }
+    return WidgetGrid::none;
+}
+
+static bool checkLayout(const char* name, float width, float height, float cell, const std::vector<Rectangle>& widgets, std::mt19937& random)
+{
+    WidgetGrid grid(width, height, cell);
+    for (const Rectangle& rec : widgets) grid.add(rec);
+    if (!grid.build()) {
+        fprintf(stderr, "widget_grid_test: %s: build failed\n", name);
+        return false;
+    }
+
+    // Random points over and around the layout, plus every widget corner and edge
+    std::vector<Vector2> points;
+    std::uniform_real_distribution<float> x(-10.0f, width + 10.0f), y(-10.0f, height + 10.0f);
+    for (int i = 0; i < 200000; i++) points.push_back((Vector2){ x(random), y(random) });
+    for (const Rectangle& rec : widgets) {
+        points.push_back((Vector2){ rec.x, rec.y });
+        points.push_back((Vector2){ rec.x + rec.width, rec.y + rec.height });
+        points.push_back((Vector2){ rec.x + rec.width - 0.01f, rec.y + rec.height - 0.01f });
+    }
+
+    for (const Vector2& point : points) {
+        int expected = linearHitTest(widgets, point);
+        int hit = grid.hitTest(point);
+        if (hit != expected) {
+            fprintf(stderr, "widget_grid_test: %s: point %.2f,%.2f hits %d, expected %d\n", name, point.x, point.y, hit, expected);
+            return false;
+        }
+    }
+
+    printf("check   %-30s %6zu widgets, %zu points: same as a linear scan\n", name, widgets.size(), points.size());
+    return true;
+}
+
+static std::vector<Rectangle> randomWidgets(size_t count, float width, float height, float maxSize, std::mt19937& random)
+{
+    std::uniform_real_distribution<float> x(0.0f, width), y(0.0f, height), size(1.0f, maxSize);
+    std::vector<Rectangle> widgets(count);
+    for (Rectangle& rec : widgets) rec = (Rectangle){ x(random), y(random), size(random), size(random) };
+    return widgets;
+}
+
+// Buttons then bands, as buildLayout() registers them in main.cpp
+static std::vector<Rectangle> calculatorWidgets()
+{
+    std::vector<Rectangle> widgets;
+    for (int i = 0; i < 9; i++) widgets.push_back((Rectangle){ 100.0f + 200*(i%3), 650.0f + 200*(i/3), 120, 120 });
+    widgets.push_back((Rectangle){ 100, 450, 120, 120 });
+    for (float x : { 130.0f, 240.0f, 350.0f, 525.0f }) widgets.push_back((Rectangle){ x, 75, 70, 250 });
+    return widgets;
+}
+
+static double elapsedNanoseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    size_t hits = (argc > 1) ? (size_t)atol(argv[1]) : 1000000;
+    std::mt19937 random(1);
+    bool ok = true;
+
+    ok &= checkLayout("calculator", 720, 1280, 80, calculatorWidgets(), random);
+    ok &= checkLayout("1000 overlapping", 720, 1280, 80, randomWidgets(1000, 720, 1280, 200, random), random);
+    ok &= checkLayout("70000+ cell entries", 720, 1280, 20, randomWidgets(400, 720, 1280, 720, random), random);
+
+    // Widget ids are 16 bits: the last id is still found, the next widget is refused
+    WidgetGrid full(100, 100, 10);
+    int last = WidgetGrid::none;
+    for (size_t i = 0; i < WidgetGrid::maxWidgets; i++) last = full.add((Rectangle){ 200, 200, 1, 1 });
+    int refused = full.add((Rectangle){ 0, 0, 1, 1 });
+    full.build();
+    bool capacity = (last == (int)WidgetGrid::maxWidgets - 1) && (refused == WidgetGrid::none) &&
+                    (full.hitTest((Vector2){ 0.5f, 0.5f }) == WidgetGrid::none);
+    printf("check   %-30s %6zu widgets: %s\n", "capacity", WidgetGrid::maxWidgets, capacity ? "last id kept, next refused" : "MISMATCH");
+    ok &= capacity;
+    if (!ok) return 1;
+
+    // Tiled layouts, one 100x100 widget per 120x120 tile: the screen grows with the widget count,
+    // widgets per cell stay the same
+    for (int side : { 4, 16, 64, 256 }) {
+        float size = 120.0f*side;
+        std::vector<Rectangle> widgets;
+        for (int y = 0; y < side; y++)
+            for (int x = 0; x < side; x++) widgets.push_back((Rectangle){ 120.0f*x + 10, 120.0f*y + 10, 100, 100 });
+
+        WidgetGrid grid(size, size, 80);
+        for (const Rectangle& rec : widgets) grid.add(rec);
+        grid.build();
+
+        std::uniform_real_distribution<float> coordinate(0.0f, size);
+        std::vector<Vector2> points(hits);
+        for (Vector2& point : points) point = (Vector2){ coordinate(random), coordinate(random) };
+
+        auto start = std::chrono::steady_clock::now();
+        long found = 0;
+        for (const Vector2& point : points) found += grid.hitTest(point);
+        double gridTime = elapsedNanoseconds(start)/(double)hits;
+
+        size_t scans = std::max<size_t>(hits/std::max<size_t>(widgets.size()/16, 1), 1000);
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < scans; i++) found += linearHitTest(widgets, points[i]);
+        double linearTime = elapsedNanoseconds(start)/(double)scans;
+
+        printf("hit     %6zu widgets: grid %6.1f ns, linear scan %9.1f ns  (%ld)\n", widgets.size(), gridTime, linearTime, found);
+    }
+
+    return 0;
+}